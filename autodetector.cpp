@@ -0,0 +1,319 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QtAlgorithms>
+#include <cstring>
+
+#include "autodetector.h"
+
+namespace {
+
+// Characters to wait for at each rate, the window is cut at the bounds.
+const int SampleChars = 48;
+const int MinWindow = 30;
+const int MaxWindow = 250;
+
+// A sample of that size is evaluated without waiting for the window to end.
+const int SampleSize = 256;
+const int MinSampleSize = 8;
+
+const double Acceptable = 0.9;
+const double Confident  = 0.98;
+
+const quint64 Ones = 0x0101010101010101ULL;
+const quint64 High = 0x8080808080808080ULL;
+
+// The validators below look at eight bytes at a time. Each returns 0x80 in
+// the bytes of the word that match, so the matches are counted with a
+// single population count and the ASCII runs cost one load per word.
+
+inline quint64 load(const uchar *p)
+{
+    quint64 w;
+    std::memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+inline quint64 equalBytes(quint64 w, uchar value)
+{
+    const quint64 y = w ^ (Ones * value);
+    return ~(((y & ~High) + ~High) | y) & High;
+}
+
+// ASCII control characters and DEL, except the usual white space.
+inline quint64 controlBytes(quint64 w)
+{
+    const quint64 below = ~((w & ~High) + Ones * 0x60) & ~w & High;
+    const quint64 space = equalBytes(w, '\t') | equalBytes(w, '\n') | equalBytes(w, '\r');
+    return (below & ~space) | equalBytes(w, 0x7f);
+}
+
+inline bool isControl(uchar c)
+{
+    return (c < 0x20 && c != '\t' && c != '\n' && c != '\r') || 0x7f == c;
+}
+
+struct Statistics {
+    int high = 0;
+    int control = 0;
+    int nul = 0;
+    int utf8Valid = 0;
+    int utf8Invalid = 0;
+    int histogram[128] = {};    // of the bytes 0x80 and above
+};
+
+void countAscii(const uchar *p, int n, Statistics &s)
+{
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const quint64 w = load(p + i);
+        s.high += qPopulationCount(w & High);
+        s.control += qPopulationCount(controlBytes(w));
+        s.nul += qPopulationCount(equalBytes(w, 0));
+    }
+
+    for (; i < n; ++i) {
+        s.high += p[i] >> 7;
+        s.control += isControl(p[i]);
+        s.nul += !p[i];
+    }
+}
+
+void countHigh(const uchar *p, int n, Statistics &s)
+{
+    int i = 0;
+    while (i < n) {
+        if (i + 8 <= n && !(load(p + i) & High)) {
+            i += 8;
+            continue;
+        }
+
+        const uchar c = p[i];
+        if (c < 0x80) {
+            ++i;
+            continue;
+        }
+
+        ++s.histogram[c - 0x80];
+        ++i;
+    }
+}
+
+void validateUtf8(const uchar *p, int n, Statistics &s)
+{
+    int i = 0;
+    while (i < n) {
+        if (i + 8 <= n && !(load(p + i) & High)) {
+            i += 8;
+            continue;
+        }
+
+        const uchar c = p[i];
+        if (c < 0x80) {
+            ++i;
+            continue;
+        }
+
+        const int length = (c >= 0xc2 && c <= 0xdf) ? 2
+                         : (c >= 0xe0 && c <= 0xef) ? 3
+                         : (c >= 0xf0 && c <= 0xf4) ? 4 : 0;
+
+        // A sequence cut by the end of the sample says nothing.
+        if (length && i + length > n)
+            break;
+
+        int k = 1;
+        while (k < length && 0x80 == (p[i + k] & 0xc0))
+            ++k;
+
+        if (!length || k < length) {
+            ++s.utf8Invalid;
+            ++i;
+        } else {
+            s.utf8Valid += length;
+            i += length;
+        }
+    }
+}
+
+int countRange(const Statistics &s, int from, int to)
+{
+    int count = 0;
+    for (int c = from; c <= to; ++c)
+        count += s.histogram[c - 0x80];
+    return count;
+}
+
+} // namespace
+
+AutoDetector::AutoDetector(QObject *parent) :
+    QObject(parent),
+    m_port(new QSerialPort(this))
+{
+    m_window.setSingleShot(true);
+    connect(&m_window, &QTimer::timeout, this, &AutoDetector::evaluate);
+    connect(m_port, &QSerialPort::readyRead, this, &AutoDetector::readSample);
+}
+
+QList<qint32> AutoDetector::candidates()
+{
+    // Fastest first, a fast device is found without waiting for slow rates.
+    return QList<qint32>() << 921600 << 460800 << 230400 << 115200 << 57600
+                           << 38400 << 19200 << 9600 << 4800 << 2400 << 1200;
+}
+
+bool AutoDetector::start(const QString &portName, QSerialPort::DataBits dataBits,
+                         QSerialPort::Parity parity, QSerialPort::StopBits stopBits)
+{
+    cancel();
+
+    m_port->setPortName(portName);
+    m_port->setDataBits(dataBits);
+    m_port->setParity(parity);
+    m_port->setStopBits(stopBits);
+    m_port->setFlowControl(QSerialPort::NoFlowControl);
+
+    if (!m_port->open(QIODevice::ReadOnly)) {
+        m_errorString = m_port->errorString();
+        return false;
+    }
+
+    m_errorString.clear();
+    m_candidates = candidates();
+    m_best = Result();
+    m_index = -1;
+    m_elapsed.start();
+
+    nextCandidate();
+    return true;
+}
+
+void AutoDetector::cancel()
+{
+    m_window.stop();
+    if (m_port->isOpen())
+        m_port->close();
+}
+
+bool AutoDetector::isRunning() const
+{
+    return m_port->isOpen();
+}
+
+void AutoDetector::nextCandidate()
+{
+    if (++m_index >= m_candidates.size()) {
+        finish(m_best.quality >= Acceptable);
+        return;
+    }
+
+    const qint32 rate = m_candidates.at(m_index);
+    if (!m_port->setBaudRate(rate)) {
+        nextCandidate();
+        return;
+    }
+
+    // Whatever came in at the previous rate must not be mixed in.
+    m_port->clear(QSerialPort::Input);
+    m_sample.clear();
+
+    // Ten bits per character cover the start and stop bits.
+    m_window.start(qBound(MinWindow, SampleChars * 10 * 1000 / rate + 1, MaxWindow));
+    emit progress(rate);
+}
+
+void AutoDetector::readSample()
+{
+    m_sample += m_port->readAll();
+    if (m_sample.size() >= SampleSize)
+        evaluate();
+}
+
+void AutoDetector::evaluate()
+{
+    if (!m_port->isOpen())
+        return;
+
+    m_window.stop();
+
+    if (m_sample.size() >= MinSampleSize) {
+        Result r = analyze(m_sample);
+        r.baudRate = m_candidates.at(m_index);
+        if (r.quality > m_best.quality)
+            m_best = r;
+    }
+
+    if (m_best.quality >= Confident && m_best.sampleSize >= SampleChars)
+        finish(true);
+    else
+        nextCandidate();
+}
+
+void AutoDetector::finish(bool ok)
+{
+    cancel();
+    m_best.msecs = m_elapsed.elapsed();
+
+    if (!ok)
+        m_errorString = m_best.sampleSize ? tr("The received data does not look like text")
+                                          : tr("No data received");
+    emit finished(ok);
+}
+
+AutoDetector::Result AutoDetector::analyze(const QByteArray &sample)
+{
+    Result result;
+    result.sampleSize = sample.size();
+    if (sample.isEmpty())
+        return result;
+
+    const uchar *p = reinterpret_cast<const uchar *>(sample.constData());
+    const int n = sample.size();
+
+    Statistics s;
+    countAscii(p, n, s);
+
+    int text = 0;
+    if (s.high) {
+        validateUtf8(p, n, s);
+        if (s.utf8Valid >= s.high * 9 / 10) {
+            result.encoding = QLatin1String("UTF-8");
+            text = s.utf8Valid;
+        } else {
+            // Lower case letters are the most frequent ones. They are
+            // 0xe0-0xff in cp1251 and 0xa0-0xaf, 0xe0-0xef in cp866.
+            countHigh(p, n, s);
+            const int lower1251 = countRange(s, 0xf0, 0xff);
+            const int lower866 = countRange(s, 0xa0, 0xaf);
+
+            if (lower866 > lower1251) {
+                result.encoding = QLatin1String("IBM 866");
+                text = countRange(s, 0x80, 0xaf) + countRange(s, 0xe0, 0xf1);
+            } else {
+                result.encoding = QLatin1String("Windows 1251");
+                text = countRange(s, 0xc0, 0xff) + s.histogram[0xa8 - 0x80]
+                        + s.histogram[0xb8 - 0x80];
+            }
+        }
+    }
+
+    // A character received at a wrong rate usually ends with a framing
+    // error, which the driver delivers as a NUL byte.
+    const int good = n - s.high - s.control - 3 * s.nul + text;
+    result.quality = qMax(0, good) / double(n);
+
+    return result;
+}
@@ -0,0 +1,74 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef AUTODETECTOR_H
+#define AUTODETECTOR_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QtSerialPort/QSerialPort>
+
+// Finds the baud rate and encoding of a device that is already talking. The
+// port is switched through the candidate rates, a short sample is taken at
+// each one and the rate whose sample looks most like text wins.
+class AutoDetector : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Result {
+        qint32 baudRate = 0;
+        QString encoding;       // empty when the sample is plain ASCII
+        double quality = 0;     // share of the sample that looks like text
+        int sampleSize = 0;
+        qint64 msecs = 0;
+    };
+
+    explicit AutoDetector(QObject *parent = nullptr);
+
+    bool start(const QString &portName, QSerialPort::DataBits dataBits,
+               QSerialPort::Parity parity, QSerialPort::StopBits stopBits);
+    void cancel();
+
+    bool isRunning() const;
+    Result result() const { return m_best; }
+    QString errorString() const { return m_errorString; }
+
+    static QList<qint32> candidates();
+    static Result analyze(const QByteArray &sample);
+
+signals:
+    void progress(qint32 baudRate);
+    void finished(bool ok);
+
+private:
+    void nextCandidate();
+    void readSample();
+    void evaluate();
+    void finish(bool ok);
+
+    QSerialPort *m_port = nullptr;
+    QTimer m_window;
+    QElapsedTimer m_elapsed;
+    QList<qint32> m_candidates;
+    QByteArray m_sample;
+    Result m_best;
+    QString m_errorString;
+    int m_index = 0;
+};
+
+#endif // AUTODETECTOR_H
@@ -0,0 +1,38 @@
+QT += testlib widgets serialport network
+
+CONFIG += c++1z console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_datapath
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+INCLUDEPATH += ..
+
+SOURCES += \
+    tst_datapath.cpp \
+    ../console.cpp \
+    ../glyphatlas.cpp \
+    ../settingsdialog.cpp \
+    ../scrollback.cpp \
+    ../samplebuffer.cpp \
+    ../valueextractor.cpp \
+    ../autodetector.cpp \
+    ../textsanitizer.cpp \
+    ../tracer.cpp \
+    ../bulksender.cpp
+
+HEADERS += \
+    ../console.h \
+    ../glyphatlas.h \
+    ../settingsdialog.h \
+    ../scrollback.h \
+    ../samplebuffer.h \
+    ../valueextractor.h \
+    ../autodetector.h \
+    ../textsanitizer.h \
+    ../tracer.h \
+    ../bulksender.h
+
+FORMS += \
+    ../settingsdialog.ui
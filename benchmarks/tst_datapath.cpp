@@ -0,0 +1,314 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QtTest>
+#include <QBuffer>
+#include <QSerialPort>
+#include <QSettings>
+#include <QTemporaryDir>
+#include <QTextCodec>
+
+#include "autodetector.h"
+#include "console.h"
+#include "scrollback.h"
+#include "settingsdialog.h"
+#include "textsanitizer.h"
+#include "tracer.h"
+
+// Micro-benchmarks of the pieces the received data passes through. The data
+// sets are generated the same way on every run so results of different
+// builds can be compared, e.g. with "-o result.xml,xml" or "-csv".
+class DataPathBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void decodeChunk_data();
+    void decodeChunk();
+
+    void analyzeSample_data();
+    void analyzeSample();
+
+    void sanitize_data();
+    void sanitize();
+
+    void putData_data();
+    void putData();
+
+    void paintConsole();
+
+    void scrollbackAppend();
+
+    void writeLog_data();
+    void writeLog();
+
+    void loadSettings();
+
+    void traceScope_data();
+    void traceScope();
+
+private:
+    static QString sampleText(int lines);
+};
+
+QString DataPathBenchmark::sampleText(int lines)
+{
+    QString text;
+    text.reserve(lines * 64);
+    for (int i = 0; i < lines; ++i) {
+        text += QStringLiteral("%1 T=%2 P=%3 [sensor] датчик OK\n")
+                .arg(i, 8, 10, QLatin1Char('0')).arg(i % 400 / 10.0).arg(1000 + i % 37);
+    }
+
+    return text;
+}
+
+void DataPathBenchmark::decodeChunk_data()
+{
+    QTest::addColumn<QString>("encoding");
+    QTest::addColumn<int>("chunkSize");
+
+    // The chunk sizes cover a single key press up to the port read buffer.
+    const char *encodings[] = { "Windows 1251", "IBM 866", "UTF-8" };
+    const int sizes[] = { 64, 1024, 10000 };
+
+    for (const char *encoding : encodings) {
+        for (int size : sizes) {
+            QTest::newRow(QByteArray(encoding) + " / " + QByteArray::number(size))
+                    << QString::fromLatin1(encoding) << size;
+        }
+    }
+}
+
+void DataPathBenchmark::decodeChunk()
+{
+    QFETCH(QString, encoding);
+    QFETCH(int, chunkSize);
+
+    QTextCodec *codec = QTextCodec::codecForName(encoding.toLatin1());
+    QVERIFY(codec);
+
+    const QByteArray data = codec->fromUnicode(sampleText(chunkSize / 32 + 1)).left(chunkSize);
+    QScopedPointer<QTextDecoder> decoder(codec->makeDecoder());
+    QString text;
+
+    QBENCHMARK {
+        text = decoder->toUnicode(data);
+    }
+
+    QVERIFY(!text.isEmpty());
+}
+
+void DataPathBenchmark::analyzeSample_data()
+{
+    QTest::addColumn<QString>("encoding");
+
+    QTest::newRow("Windows 1251") << QStringLiteral("Windows 1251");
+    QTest::newRow("IBM 866") << QStringLiteral("IBM 866");
+    QTest::newRow("UTF-8") << QStringLiteral("UTF-8");
+}
+
+void DataPathBenchmark::analyzeSample()
+{
+    QFETCH(QString, encoding);
+
+    QTextCodec *codec = QTextCodec::codecForName(encoding.toLatin1());
+    QVERIFY(codec);
+
+    const QByteArray sample = codec->fromUnicode(sampleText(64));
+    AutoDetector::Result result;
+
+    QBENCHMARK {
+        result = AutoDetector::analyze(sample);
+    }
+
+    QCOMPARE(result.encoding, encoding);
+}
+
+void DataPathBenchmark::sanitize_data()
+{
+    QTest::addColumn<int>("mode");
+    QTest::addColumn<bool>("binary");
+
+    QTest::newRow("text / show") << int(TextSanitizer::EscapeControlChars) << false;
+    QTest::newRow("random bytes / show") << int(TextSanitizer::EscapeControlChars) << true;
+    QTest::newRow("random bytes / collapse") << int(TextSanitizer::CollapseControlChars) << true;
+}
+
+void DataPathBenchmark::sanitize()
+{
+    QFETCH(int, mode);
+    QFETCH(bool, binary);
+
+    // Random bytes as they come out of the decoder at a wrong baud rate.
+    QByteArray bytes(10000, Qt::Uninitialized);
+    quint32 seed = 1;
+    for (char &c : bytes) {
+        seed = seed * 1103515245 + 12345;
+        c = char(seed >> 16);
+    }
+
+    const QString text = binary ? QTextCodec::codecForName("UTF-8")->toUnicode(bytes)
+                                : sampleText(200);
+
+    TextSanitizer sanitizer;
+    sanitizer.setMaxLineLength(2048);
+    sanitizer.setControlChars(static_cast<TextSanitizer::ControlChars>(mode));
+
+    QBENCHMARK {
+        sanitizer.process(text);
+    }
+}
+
+void DataPathBenchmark::putData_data()
+{
+    QTest::addColumn<int>("documentLines");
+
+    QTest::newRow("empty") << 0;
+    QTest::newRow("10k lines") << 10000;
+    QTest::newRow("100k lines") << 100000;
+}
+
+void DataPathBenchmark::putData()
+{
+    QFETCH(int, documentLines);
+
+    QSerialPort port;
+    Console console(nullptr, &port);
+    console.resize(800, 600);
+
+    if (documentLines)
+        console.putData(sampleText(documentLines));
+
+    const QString line = sampleText(1);
+
+    QBENCHMARK {
+        console.putData(line);
+    }
+}
+
+void DataPathBenchmark::paintConsole()
+{
+    QSerialPort port;
+    Console console(nullptr, &port);
+    console.resize(800, 600);
+    console.putData(sampleText(10000));
+
+    QImage image(console.viewport()->size(), QImage::Format_ARGB32_Premultiplied);
+
+    // The first pass fills the glyph atlas, the measured ones only draw.
+    console.viewport()->render(&image);
+
+    QBENCHMARK {
+        console.viewport()->render(&image);
+    }
+}
+
+void DataPathBenchmark::scrollbackAppend()
+{
+    const QString chunk = sampleText(100);
+    Scrollback scrollback;
+
+    QBENCHMARK {
+        scrollback.append(chunk);
+    }
+
+    QVERIFY(scrollback.lineCount() >= 100);
+}
+
+void DataPathBenchmark::writeLog_data()
+{
+    QTest::addColumn<int>("lines");
+
+    QTest::newRow("10k lines") << 10000;
+    QTest::newRow("1M lines") << 1000000;
+}
+
+void DataPathBenchmark::writeLog()
+{
+    QFETCH(int, lines);
+
+    Scrollback scrollback;
+    const QString chunk = sampleText(1000);
+    for (int i = 0; i < lines / 1000; ++i)
+        scrollback.append(chunk);
+
+    QBENCHMARK {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        QVERIFY(scrollback.write(&buffer));
+    }
+}
+
+void DataPathBenchmark::loadSettings()
+{
+    // A fixed ini rather than whatever lies next to the binary.
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QStringLiteral("settings.ini"));
+    {
+        QSettings ini(fileName, QSettings::IniFormat);
+        ini.setValue(QLatin1String("Port"), QLatin1String("ttyUSB0"));
+        ini.setValue(QLatin1String("Baudrate"), QLatin1String("250000"));
+        ini.setValue(QLatin1String("BaudrateBoxIndex"), 5);
+        ini.setValue(QLatin1String("Parity"), QLatin1String("Even"));
+        ini.setValue(QLatin1String("Encoding"), QLatin1String("UTF-8"));
+        ini.setValue(QLatin1String("MaxLineLength"), 4096);
+        ini.setValue(QLatin1String("PastePrompt"), QLatin1String("> "));
+        ini.setValue(QLatin1String("PlotPatterns"), QStringList()
+                     << QLatin1String("T=(-?\\d+(?:\\.\\d+)?)")
+                     << QLatin1String("P=(\\d+)"));
+        ini.setValue(QLatin1String("Bridge"), true);
+        QVERIFY(QSettings::NoError == ini.status());
+    }
+
+    // The widgets and the port list are built once, only the reading counts.
+    SettingsDialog dialog(fileName);
+
+    QBENCHMARK {
+        dialog.load(fileName);
+    }
+
+    QCOMPARE(dialog.settings().maxLineLength, 4096);
+}
+
+void DataPathBenchmark::traceScope_data()
+{
+    QTest::addColumn<bool>("enabled");
+
+    QTest::newRow("disabled") << false;
+    QTest::newRow("enabled") << true;
+}
+
+void DataPathBenchmark::traceScope()
+{
+    QFETCH(bool, enabled);
+
+    Tracer::clear();
+    Tracer::setEnabled(enabled);
+
+    // A thousand spans per iteration, a single one is below the timer resolution.
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i)
+            TRACE_SCOPE("benchmark");
+    }
+
+    Tracer::setEnabled(false);
+}
+
+QTEST_MAIN(DataPathBenchmark)
+
+#include "tst_datapath.moc"
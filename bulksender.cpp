@@ -0,0 +1,176 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QIODevice>
+
+#include "bulksender.h"
+
+namespace {
+
+// Unpaced data is written in pieces while the port holds less than this,
+// so progress and cancel follow the wire instead of the write buffer.
+const int ChunkSize = 256;
+const qint64 HighWater = 1024;
+
+// How long a line waits for the prompt before the rest is given up.
+const int PromptTimeout = 10000;
+
+} // namespace
+
+BulkSender::BulkSender(QIODevice *device, QObject *parent) : QObject(parent),
+    m_device(device)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &BulkSender::timeout);
+    connect(m_device, &QIODevice::bytesWritten, this, &BulkSender::bytesWritten);
+}
+
+QStringList BulkSender::pacingNames()
+{
+    return QStringList()
+            << tr("None")
+            << tr("Per character")
+            << tr("Per line");
+}
+
+void BulkSender::setPacing(Pacing pacing, int delay, const QByteArray &prompt)
+{
+    m_pacing = pacing;
+    m_delay = qMax(0, delay);
+    m_prompt = prompt;
+}
+
+void BulkSender::send(const QByteArray &data)
+{
+    if (data.isEmpty())
+        return;
+
+    // Another paste while one runs joins the same queue.
+    m_queue += data;
+    emit progress(m_offset, m_queue.size());
+
+    if (!m_running) {
+        m_running = true;
+        sendNext();
+    }
+}
+
+void BulkSender::cancel()
+{
+    if (m_running)
+        finish(false, tr("Sending cancelled, %1 of %2 bytes sent")
+               .arg(m_offset).arg(m_queue.size()));
+}
+
+void BulkSender::feed(const QByteArray &data)
+{
+    if (!m_waiting)
+        return;
+
+    m_rx += data;
+    if (!m_rx.contains(m_prompt)) {
+        // Keep just enough for a prompt split across reads.
+        if (m_rx.size() >= m_prompt.size())
+            m_rx.remove(0, m_rx.size() - m_prompt.size() + 1);
+        return;
+    }
+
+    m_waiting = false;
+    m_rx.clear();
+    m_timer.start(m_delay);
+}
+
+void BulkSender::sendNext()
+{
+    if (!m_running || m_waiting)
+        return;
+
+    if (m_offset >= m_queue.size()) {
+        finish(true, tr("%1 bytes sent").arg(m_queue.size()));
+        return;
+    }
+
+    switch (m_pacing) {
+    case NoPacing:
+        // The rest follows from bytesWritten().
+        while (m_offset < m_queue.size() && m_device->bytesToWrite() < HighWater)
+            write(ChunkSize);
+        if (m_offset >= m_queue.size())
+            finish(true, tr("%1 bytes sent").arg(m_queue.size()));
+        break;
+    case PerCharacter:
+        write(1);
+        m_timer.start(m_delay);
+        break;
+    case PerLine: {
+        // Pasted lines end with CR, dropped files may use any convention.
+        int end = m_offset;
+        while (end < m_queue.size() && '\r' != m_queue.at(end) && '\n' != m_queue.at(end))
+            ++end;
+        if (end < m_queue.size() && '\r' == m_queue.at(end) && end + 1 < m_queue.size()
+                && '\n' == m_queue.at(end + 1))
+            ++end;
+        write(end - m_offset + 1);
+
+        if (!m_prompt.isEmpty() && m_offset < m_queue.size()) {
+            m_waiting = true;
+            m_rx.clear();
+            m_timer.start(PromptTimeout);
+        } else {
+            m_timer.start(m_delay);
+        }
+        break;
+    }
+    }
+}
+
+void BulkSender::bytesWritten()
+{
+    if (NoPacing == m_pacing)
+        sendNext();
+}
+
+void BulkSender::timeout()
+{
+    if (!m_waiting) {
+        sendNext();
+        return;
+    }
+
+    finish(false, tr("The prompt did not appear, %1 of %2 bytes sent")
+           .arg(m_offset).arg(m_queue.size()));
+}
+
+void BulkSender::write(int size)
+{
+    size = qMin(size, m_queue.size() - m_offset);
+    m_device->write(m_queue.constData() + m_offset, size);
+    m_offset += size;
+
+    emit progress(m_offset, m_queue.size());
+}
+
+void BulkSender::finish(bool ok, const QString &message)
+{
+    m_timer.stop();
+    m_queue.clear();
+    m_rx.clear();
+    m_offset = 0;
+    m_running = false;
+    m_waiting = false;
+
+    emit finished(ok, message);
+}
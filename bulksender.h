@@ -0,0 +1,82 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef BULKSENDER_H
+#define BULKSENDER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QStringList>
+#include <QTimer>
+
+QT_BEGIN_NAMESPACE
+class QIODevice;
+QT_END_NAMESPACE
+
+// Sends pasted and dropped data through one queue. Unpaced data is handed
+// to the port a little at a time as it drains, slow targets can be given a
+// delay after every character or line, or a prompt to wait for before the
+// next line.
+class BulkSender : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Pacing {
+        NoPacing,
+        PerCharacter,
+        PerLine
+    };
+
+    explicit BulkSender(QIODevice *device, QObject *parent = nullptr);
+
+    static QStringList pacingNames();
+
+    void setPacing(Pacing pacing, int delay, const QByteArray &prompt = QByteArray());
+
+    void send(const QByteArray &data);
+    void cancel();
+    bool isRunning() const { return m_running; }
+
+    // Received data, searched for the prompt while a line waits for it.
+    void feed(const QByteArray &data);
+
+signals:
+    void progress(qint64 done, qint64 total);
+    void finished(bool ok, const QString &message);
+
+private slots:
+    void sendNext();
+    void bytesWritten();
+    void timeout();
+
+private:
+    void write(int size);
+    void finish(bool ok, const QString &message);
+
+    QIODevice *m_device = nullptr;
+    QTimer m_timer;
+    QByteArray m_queue;
+    QByteArray m_prompt;
+    QByteArray m_rx;
+    Pacing m_pacing = NoPacing;
+    int m_delay  = 0;
+    int m_offset = 0;
+    bool m_running = false;
+    bool m_waiting = false;
+};
+
+#endif // BULKSENDER_H
@@ -32,13 +32,41 @@
 **
 ****************************************************************************/
 
+
 #include <QScrollBar>
 #include <QKeyEvent>
+#include <QApplication>
+#include <QClipboard>
+#include <QMimeData>
+#include <QFontDatabase>
+#include <QMenu>
+#include <QPainter>
 #include <QtSerialPort/QtSerialPort>
+#include <algorithm>
 #include "console.h"
+#include "tracer.h"
+
+namespace {
+
+const QRgb EchoColor = qRgb(255, 0, 0);
+const int TabWidth = 8;
+
+// Control characters are sent but not echoed.
+QString printable(const QString &text)
+{
+    QString result;
+    result.reserve(text.size());
+    for (const QChar c : text) {
+        if (c.unicode() >= 0x20 && c.unicode() != 0x7f)
+            result += c;
+    }
+    return result;
+}
+
+} // namespace
 
 Console::Console(QWidget *parent, QSerialPort *port):
-    QTextEdit(parent),
+    QAbstractScrollArea(parent),
     m_port(port),
     localEchoEnabled(true)
 {
@@ -47,32 +75,104 @@ Console::Console(QWidget *parent, QSerialPort *port):
     p.setColor(QPalette::Text, Qt::green);
     setPalette(p);
 
-    setAcceptRichText(false);
+    setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    setFocusPolicy(Qt::StrongFocus);
+    viewport()->setCursor(Qt::IBeamCursor);
+    viewport()->setAcceptDrops(true);
 
-    m_inputTimer.setSingleShot(true);
+    // Every pixel is painted, the background does not need to be cleared.
+    viewport()->setAttribute(Qt::WA_OpaquePaintEvent);
 
-    connect(&m_inputTimer, &QTimer::timeout, [&](){
+    m_atlas.setFont(font(), devicePixelRatioF());
+    updateScrollBars();
 
-        QTextCursor m_cursor = textCursor();
-        m_cursor.movePosition(QTextCursor::End, QTextCursor::MoveAnchor);
-
-        setTextCursor(m_cursor);
-        insertPlainText("\n");
+    m_inputTimer.setSingleShot(true);
 
-        QScrollBar *bar = verticalScrollBar();
-        bar->setValue(bar->maximum());
+    connect(&m_inputTimer, &QTimer::timeout, [&](){
+        append(QStringLiteral("\n"), false);
+        scrollToBottom();
     });
 }
 
 void Console::putData(const QString &data)
 {
-    if (QColor(Qt::green) != textColor())
-        setTextColor(Qt::green);
+    append(data, false);
+}
 
-    insertPlainText(data);
+void Console::append(const QString &text, bool echo)
+{
+    TRACE_SCOPE("Console::append");
 
-    QScrollBar *bar = verticalScrollBar();
-    bar->setValue(bar->maximum());
+    if (text.isEmpty())
+        return;
+
+    const bool follow = isAtBottom();
+    const qint64 first = m_lines.completeLineCount();
+
+    // A CR that ended the previous chunk has ended the line already, the LF
+    // after it is part of the same line end.
+    int i = m_pendingReturn && QLatin1Char('\n') == text.at(0) ? 1 : 0;
+
+    // Tabs are expanded to their stops and CR, LF and CR LF all end a line
+    // the way they did in the text edit, so every stored character is one
+    // cell wide.
+    QString cells;
+    cells.reserve(text.size());
+    const int start = m_column;
+    for (; i < text.size(); ++i) {
+        const QChar c = text.at(i);
+        if (QLatin1Char('\t') == c) {
+            const int spaces = TabWidth - m_column % TabWidth;
+            cells.append(QString(spaces, QLatin1Char(' ')));
+            m_column += spaces;
+        } else if (QLatin1Char('\r') == c || QLatin1Char('\n') == c) {
+            if (QLatin1Char('\r') == c && i + 1 < text.size() && QLatin1Char('\n') == text.at(i + 1))
+                ++i;
+            cells += QLatin1Char('\n');
+            m_maxColumns = qMax(m_maxColumns, m_column);
+            m_column = 0;
+        } else if (c.isSurrogate()) {
+            // The atlas draws one QChar per cell, a character outside the
+            // BMP is shown as a single replacement character.
+            if (c.isHighSurrogate() && i + 1 < text.size() && text.at(i + 1).isLowSurrogate())
+                ++i;
+            cells += QChar(QChar::ReplacementCharacter);
+            ++m_column;
+        } else {
+            cells += c;
+            ++m_column;
+        }
+    }
+    m_maxColumns = qMax(m_maxColumns, m_column);
+    m_pendingReturn = text.endsWith(QLatin1Char('\r'));
+
+    if (echo) {
+        if (!m_echo.isEmpty() && m_echo.last().line == first && m_echo.last().to == start)
+            m_echo.last().to += cells.size();
+        else
+            m_echo.append({ first, start, start + int(cells.size()) });
+    }
+
+    m_lines.append(cells);
+
+    updateScrollBars();
+    if (follow)
+        scrollToBottom();
+
+    updateLines(first, m_lines.lineCount());
+}
+
+void Console::clear()
+{
+    m_lines.clear();
+    m_echo.clear();
+    m_column = 0;
+    m_pendingReturn = false;
+    m_maxColumns = 0;
+    m_anchor = m_cursor = Position();
+
+    updateScrollBars();
+    viewport()->update();
 }
 
 void Console::setLocalEchoEnabled(bool set)
@@ -84,6 +184,34 @@ void Console::keyPressEvent(QKeyEvent *e)
 {
     Q_CHECK_PTR(m_port);
 
+    // The terminal keys for paste, Ctrl+V itself still goes to the device.
+    if ((Qt::Key_Insert == e->key() && Qt::ShiftModifier == e->modifiers())
+            || (Qt::Key_V == e->key() && (Qt::ControlModifier | Qt::ShiftModifier) == e->modifiers())) {
+        paste();
+        return;
+    }
+
+    // Shift with the paging keys scrolls the console, nothing is sent.
+    if (e->modifiers() & Qt::ShiftModifier) {
+        QScrollBar *bar = verticalScrollBar();
+        switch (e->key()) {
+        case Qt::Key_PageUp:
+            bar->triggerAction(QAbstractSlider::SliderPageStepSub);
+            return;
+        case Qt::Key_PageDown:
+            bar->triggerAction(QAbstractSlider::SliderPageStepAdd);
+            return;
+        case Qt::Key_Home:
+            bar->triggerAction(QAbstractSlider::SliderToMinimum);
+            return;
+        case Qt::Key_End:
+            bar->triggerAction(QAbstractSlider::SliderToMaximum);
+            return;
+        default:
+            break;
+        }
+    }
+
     if (m_port->isOpen()) {
         emit getData(e->text().toLocal8Bit());
         m_inputTimer.start(std::chrono::seconds(5));
@@ -91,12 +219,81 @@ void Console::keyPressEvent(QKeyEvent *e)
         localEchoEnabled = true;
     }
 
-    if (localEchoEnabled) {
-        if (QColor(Qt::red) != textColor())
-            setTextColor(Qt::red);
+    if (localEchoEnabled)
+        echo(e);
+}
+
+void Console::echo(const QKeyEvent *e)
+{
+    switch (e->key()) {
+    case Qt::Key_Return:
+    case Qt::Key_Enter:
+        append(QStringLiteral("\n"), false);
+        break;
+    case Qt::Key_Backspace:
+        erase();
+        break;
+    default:
+        append(printable(e->text()), true);
+        break;
+    }
+
+    scrollToBottom();
+}
+
+void Console::paste()
+{
+    insertText(QApplication::clipboard()->text());
+}
+
+// Pasted and dropped text goes out as a whole, not key by key, and does not
+// hold the display back like typing does.
+void Console::insertText(const QString &text)
+{
+    Q_CHECK_PTR(m_port);
 
-        QTextEdit::keyPressEvent(e);
+    if (text.isEmpty())
+        return;
+
+    if (m_port->isOpen())
+        emit pasteData(text);
+    else
+        localEchoEnabled = true;
+
+    if (!localEchoEnabled)
+        return;
+
+    int from = 0;
+    for (;;) {
+        const int end = text.indexOf(QLatin1Char('\n'), from);
+        append(printable(text.mid(from, end < 0 ? -1 : end - from)), true);
+        if (end < 0)
+            break;
+
+        append(QStringLiteral("\n"), false);
+        from = end + 1;
     }
+
+    scrollToBottom();
+}
+
+void Console::erase()
+{
+    // Only typed characters not followed by received ones can be taken back.
+    if (m_echo.isEmpty())
+        return;
+
+    EchoSpan &span = m_echo.last();
+    const qint64 line = m_lines.completeLineCount();
+    if (span.line != line || span.to != m_column)
+        return;
+
+    m_lines.chop(1);
+    --m_column;
+    if (--span.to == span.from)
+        m_echo.removeLast();
+
+    updateLines(line, line + 1);
 }
 
 bool Console::isBusy() const
@@ -104,3 +301,254 @@ bool Console::isBusy() const
     return m_inputTimer.isActive();
 }
 
+bool Console::hasSelection() const
+{
+    return m_anchor != m_cursor;
+}
+
+QString Console::selectedText() const
+{
+    if (!hasSelection())
+        return QString();
+
+    const Position from = qMin(m_anchor, m_cursor);
+    const Position to = qMax(m_anchor, m_cursor);
+
+    QString text;
+    for (qint64 line = from.line; line <= to.line; ++line) {
+        const QString row = m_lines.line(line);
+        const int start = line == from.line ? qMin(from.column, row.size()) : 0;
+        const int end = line == to.line ? qMin(to.column, row.size()) : row.size();
+
+        text += row.midRef(start, end - start);
+        if (line != to.line)
+            text += QLatin1Char('\n');
+    }
+
+    return text;
+}
+
+void Console::copy()
+{
+    if (hasSelection())
+        QApplication::clipboard()->setText(selectedText());
+}
+
+void Console::selectAll()
+{
+    m_anchor = Position();
+    m_cursor.line = qMax<qint64>(0, m_lines.lineCount() - 1);
+    m_cursor.column = m_lines.line(m_cursor.line).size();
+    viewport()->update();
+}
+
+bool Console::isAtBottom() const
+{
+    const QScrollBar *bar = verticalScrollBar();
+    return bar->value() == bar->maximum();
+}
+
+void Console::scrollToBottom()
+{
+    QScrollBar *bar = verticalScrollBar();
+    bar->setValue(bar->maximum());
+}
+
+void Console::updateScrollBars()
+{
+    TRACE_SCOPE("Console::updateScrollBars");
+
+    const QSize cell = m_atlas.cellSize();
+    const int rows = qMax(1, viewport()->height() / cell.height());
+
+    QScrollBar *v = verticalScrollBar();
+    v->setRange(0, int(qMax<qint64>(0, m_lines.lineCount() - rows)));
+    v->setPageStep(rows);
+
+    QScrollBar *h = horizontalScrollBar();
+    h->setRange(0, qMax(0, (m_maxColumns + 1) * cell.width() - viewport()->width()));
+    h->setPageStep(viewport()->width());
+    h->setSingleStep(cell.width());
+}
+
+void Console::updateLines(qint64 first, qint64 last)
+{
+    const int rowHeight = m_atlas.cellSize().height();
+    const qint64 top = verticalScrollBar()->value();
+    const qint64 bottom = top + viewport()->height() / rowHeight + 1;
+
+    first = qMax(first, top);
+    last = qMin(qMax(last, first + 1), bottom);
+    if (first >= last)
+        return;
+
+    viewport()->update(QRect(0, int(first - top) * rowHeight,
+                             viewport()->width(), int(last - first) * rowHeight));
+}
+
+void Console::scrollContentsBy(int dx, int dy)
+{
+    TRACE_SCOPE("Console::scrollContentsBy");
+
+    // The scroll bars count pixels across and rows down.
+    viewport()->scroll(dx, dy * m_atlas.cellSize().height());
+}
+
+void Console::resizeEvent(QResizeEvent *e)
+{
+    const bool follow = isAtBottom();
+    QAbstractScrollArea::resizeEvent(e);
+
+    updateScrollBars();
+    if (follow)
+        scrollToBottom();
+}
+
+void Console::changeEvent(QEvent *e)
+{
+    if (QEvent::FontChange == e->type()) {
+        m_atlas.setFont(font(), devicePixelRatioF());
+        updateScrollBars();
+        viewport()->update();
+    }
+
+    QAbstractScrollArea::changeEvent(e);
+}
+
+void Console::paintEvent(QPaintEvent *e)
+{
+    TRACE_SCOPE("Console::paintEvent");
+
+    // The window may have moved to a screen with another pixel ratio.
+    if (!qFuzzyCompare(m_atlas.devicePixelRatio(), devicePixelRatioF()))
+        m_atlas.setFont(font(), devicePixelRatioF());
+
+    QPainter painter(viewport());
+    const QRect area = e->rect();
+    painter.fillRect(area, palette().color(QPalette::Base));
+
+    const QSize cell = m_atlas.cellSize();
+    const int xOffset = horizontalScrollBar()->value();
+    const qint64 top = verticalScrollBar()->value();
+    const qint64 lines = m_lines.lineCount();
+
+    const int firstRow = area.top() / cell.height();
+    const int lastRow = area.bottom() / cell.height();
+    const int firstColumn = qMax(0, (area.left() + xOffset) / cell.width());
+    const int lastColumn = (area.right() + xOffset) / cell.width();
+
+    const Position selectionStart = qMin(m_anchor, m_cursor);
+    const Position selectionEnd = qMax(m_anchor, m_cursor);
+    const QRgb textColor = palette().color(QPalette::Text).rgba();
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        const qint64 line = top + row;
+        if (line >= lines)
+            break;
+
+        const QString text = m_lines.line(line);
+        const int y = row * cell.height();
+
+        if (hasSelection() && line >= selectionStart.line && line <= selectionEnd.line) {
+            const int from = line == selectionStart.line ? selectionStart.column : 0;
+            const int to = line == selectionEnd.line ? selectionEnd.column : text.size() + 1;
+            painter.fillRect(QRect(from * cell.width() - xOffset, y,
+                                   (to - from) * cell.width(), cell.height()),
+                             palette().color(QPalette::Highlight));
+        }
+
+        const int end = qMin(text.size(), lastColumn + 1);
+
+        // Typed characters interrupt the received text with their own colour.
+        auto span = std::lower_bound(m_echo.cbegin(), m_echo.cend(), line,
+                                     [](const EchoSpan &s, qint64 l) { return s.line < l; });
+        int column = firstColumn;
+        while (column < end) {
+            while (span != m_echo.cend() && span->line == line && span->to <= column)
+                ++span;
+
+            const bool onLine = span != m_echo.cend() && span->line == line;
+            const bool echoed = onLine && span->from <= column;
+            const int next = echoed ? qMin(span->to, end) : onLine ? qMin(span->from, end) : end;
+
+            m_atlas.draw(&painter, QPoint(column * cell.width() - xOffset, y),
+                         text.constData() + column, next - column,
+                         echoed ? EchoColor : textColor);
+            column = next;
+        }
+    }
+}
+
+Console::Position Console::positionAt(const QPoint &pos) const
+{
+    const QSize cell = m_atlas.cellSize();
+    const qint64 row = pos.y() < 0 ? -1 : pos.y() / cell.height();
+
+    Position p;
+    p.line = qBound<qint64>(0, verticalScrollBar()->value() + row,
+                            qMax<qint64>(0, m_lines.lineCount() - 1));
+    p.column = qMax(0, (pos.x() + horizontalScrollBar()->value() + cell.width() / 2)
+                    / cell.width());
+    return p;
+}
+
+void Console::mousePressEvent(QMouseEvent *e)
+{
+    if (Qt::LeftButton == e->button()) {
+        m_anchor = m_cursor = positionAt(e->pos());
+        viewport()->update();
+    }
+}
+
+void Console::mouseMoveEvent(QMouseEvent *e)
+{
+    if (e->buttons() & Qt::LeftButton) {
+        // Dragging past the edge scrolls the selection on.
+        QScrollBar *bar = verticalScrollBar();
+        if (e->pos().y() < 0)
+            bar->triggerAction(QAbstractSlider::SliderSingleStepSub);
+        else if (e->pos().y() > viewport()->height())
+            bar->triggerAction(QAbstractSlider::SliderSingleStepAdd);
+
+        m_cursor = positionAt(e->pos());
+        viewport()->update();
+    }
+}
+
+void Console::contextMenuEvent(QContextMenuEvent *e)
+{
+    QMenu menu(this);
+    QAction *copyAction = menu.addAction(tr("&Copy"), this, &Console::copy);
+    copyAction->setEnabled(hasSelection());
+    QAction *pasteAction = menu.addAction(tr("&Paste"), this, &Console::paste);
+    pasteAction->setEnabled(!QApplication::clipboard()->text().isEmpty());
+    menu.addAction(tr("Select &All"), this, &Console::selectAll);
+    menu.exec(e->globalPos());
+}
+
+void Console::dragEnterEvent(QDragEnterEvent *e)
+{
+    if (e->mimeData()->hasUrls() || e->mimeData()->hasText())
+        e->acceptProposedAction();
+}
+
+void Console::dropEvent(QDropEvent *e)
+{
+    const QMimeData *mime = e->mimeData();
+
+    // Dropped files are sent as they are, like the ones opened from the menu.
+    QStringList fileNames;
+    for (const QUrl &url : mime->urls()) {
+        if (url.isLocalFile())
+            fileNames.append(url.toLocalFile());
+    }
+
+    if (!fileNames.isEmpty())
+        emit dropFiles(fileNames);
+    else if (mime->hasText())
+        insertText(mime->text());
+    else
+        return;
+
+    e->acceptProposedAction();
+}
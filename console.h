@@ -35,14 +35,20 @@
 #ifndef CONSOLE_H
 #define CONSOLE_H
 
-#include <QTextEdit>
+#include <QAbstractScrollArea>
 #include <QTimer>
 
+#include "glyphatlas.h"
+#include "scrollback.h"
+
 QT_BEGIN_NAMESPACE
 class QSerialPort;
 QT_END_NAMESPACE
 
-class Console : public QTextEdit
+// A fixed cell terminal view. Rows are painted from the glyph atlas, only
+// the rows that changed are repainted and scrolling moves the pixels that
+// are already on screen.
+class Console : public QAbstractScrollArea
 {
     Q_OBJECT
 
@@ -52,11 +58,59 @@ public:
     void setLocalEchoEnabled(bool set);
 
     bool isBusy() const;
+    bool hasSelection() const;
+    QString selectedText() const;
+
+public slots:
+    void clear();
+    void copy();
+    void paste();
+    void selectAll();
 
 protected:
     virtual void keyPressEvent(QKeyEvent *e);
+    void paintEvent(QPaintEvent *e) Q_DECL_OVERRIDE;
+    void resizeEvent(QResizeEvent *e) Q_DECL_OVERRIDE;
+    void changeEvent(QEvent *e) Q_DECL_OVERRIDE;
+    void scrollContentsBy(int dx, int dy) Q_DECL_OVERRIDE;
+    void mousePressEvent(QMouseEvent *e) Q_DECL_OVERRIDE;
+    void mouseMoveEvent(QMouseEvent *e) Q_DECL_OVERRIDE;
+    void contextMenuEvent(QContextMenuEvent *e) Q_DECL_OVERRIDE;
+    void dragEnterEvent(QDragEnterEvent *e) Q_DECL_OVERRIDE;
+    void dropEvent(QDropEvent *e) Q_DECL_OVERRIDE;
 
 private:
+    struct Position {
+        qint64 line = 0;
+        int column = 0;
+
+        bool operator<(const Position &other) const
+        {
+            return line < other.line || (line == other.line && column < other.column);
+        }
+        bool operator!=(const Position &other) const
+        {
+            return line != other.line || column != other.column;
+        }
+    };
+
+    // Characters typed with local echo on, shown in their own colour.
+    struct EchoSpan {
+        qint64 line;
+        int from;
+        int to;
+    };
+
+    void append(const QString &text, bool echo);
+    void echo(const QKeyEvent *e);
+    void insertText(const QString &text);
+    void erase();
+    void updateScrollBars();
+    void updateLines(qint64 first, qint64 last);
+    bool isAtBottom() const;
+    void scrollToBottom();
+    Position positionAt(const QPoint &pos) const;
+
     QTimer m_inputTimer;
     QSerialPort *m_port = nullptr;
     bool localEchoEnabled;
@@ -69,8 +123,20 @@ private:
     qint8 _padding3;
     qint8 _padding4;
 
+    GlyphAtlas m_atlas;
+    Scrollback m_lines;
+    QVector<EchoSpan> m_echo;
+    int m_column = 0;
+    int m_maxColumns = 0;
+    bool m_pendingReturn = false;
+
+    Position m_anchor;
+    Position m_cursor;
+
 signals:
     void getData(const QByteArray &data);
+    void pasteData(const QString &text);
+    void dropFiles(const QStringList &fileNames);
 
 };
 
@@ -0,0 +1,169 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QFontDatabase>
+#include <QSettings>
+#include <QSignalBlocker>
+#include <QTime>
+
+#include "expectdialog.h"
+#include "expectresponder.h"
+#include "settingsdialog.h"
+#include "ui_expectdialog.h"
+
+namespace {
+
+enum Column {
+    PatternColumn,
+    ResponseColumn,
+    DelayColumn,
+    RepeatColumn
+};
+
+} // namespace
+
+ExpectDialog::ExpectDialog(ExpectResponder *responder, QWidget *parent) :
+    QDialog(parent),
+    ui(new Ui::ExpectDialog),
+    m_responder(responder)
+{
+    ui->setupUi(this);
+    ui->logEdit->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    ui->logEdit->setMaximumBlockCount(1000);
+
+    load();
+
+    connect(ui->addButton, &QPushButton::clicked, this, &ExpectDialog::addRule);
+    connect(ui->removeButton, &QPushButton::clicked, this, &ExpectDialog::removeRule);
+    connect(ui->rearmButton, &QPushButton::clicked, m_responder, &ExpectResponder::rearm);
+    connect(ui->rulesTable, &QTableWidget::itemChanged, this, &ExpectDialog::applyRules);
+    connect(ui->enabledCheckBox, &QCheckBox::toggled, this, &ExpectDialog::applyRules);
+    connect(m_responder, &ExpectResponder::responded, this, &ExpectDialog::logResponse);
+}
+
+ExpectDialog::~ExpectDialog()
+{
+    delete ui;
+}
+
+void ExpectDialog::appendRow(const QString &pattern, const QString &response, int delay,
+                             bool repeat)
+{
+    // The rules are applied once the row is complete and edited.
+    const QSignalBlocker blocker(ui->rulesTable);
+
+    const int row = ui->rulesTable->rowCount();
+    ui->rulesTable->insertRow(row);
+
+    QTableWidgetItem *delayItem = new QTableWidgetItem;
+    delayItem->setData(Qt::EditRole, delay);
+
+    QTableWidgetItem *repeatItem = new QTableWidgetItem;
+    repeatItem->setFlags(Qt::ItemIsEnabled | Qt::ItemIsUserCheckable);
+    repeatItem->setCheckState(repeat ? Qt::Checked : Qt::Unchecked);
+
+    ui->rulesTable->setItem(row, PatternColumn, new QTableWidgetItem(pattern));
+    ui->rulesTable->setItem(row, ResponseColumn, new QTableWidgetItem(response));
+    ui->rulesTable->setItem(row, DelayColumn, delayItem);
+    ui->rulesTable->setItem(row, RepeatColumn, repeatItem);
+}
+
+void ExpectDialog::addRule()
+{
+    appendRow(QString(), QStringLiteral("\\r"), 0, false);
+    ui->rulesTable->editItem(ui->rulesTable->item(ui->rulesTable->rowCount() - 1,
+                                                  PatternColumn));
+}
+
+void ExpectDialog::removeRule()
+{
+    const int row = ui->rulesTable->currentRow();
+    if (-1 == row)
+        return;
+
+    ui->rulesTable->removeRow(row);
+    applyRules();
+}
+
+void ExpectDialog::applyRules()
+{
+    QVector<ExpectResponder::Rule> rules;
+    for (int row = 0; row < ui->rulesTable->rowCount(); ++row) {
+        const QTableWidgetItem *pattern = ui->rulesTable->item(row, PatternColumn);
+        const QTableWidgetItem *response = ui->rulesTable->item(row, ResponseColumn);
+        const QTableWidgetItem *delay = ui->rulesTable->item(row, DelayColumn);
+        const QTableWidgetItem *repeat = ui->rulesTable->item(row, RepeatColumn);
+
+        if (pattern->text().isEmpty())
+            continue;
+
+        ExpectResponder::Rule rule;
+        rule.pattern = ExpectResponder::unescape(pattern->text());
+        rule.response = ExpectResponder::unescape(response->text());
+        rule.delay = delay->data(Qt::EditRole).toInt();
+        rule.repeat = Qt::Checked == repeat->checkState();
+        rules.append(rule);
+    }
+
+    m_responder->setRules(rules);
+    m_responder->setEnabled(ui->enabledCheckBox->isChecked());
+    save();
+}
+
+void ExpectDialog::logResponse(const QByteArray &pattern, qint64 nsecs)
+{
+    ui->logEdit->appendPlainText(tr("%1  \"%2\" answered in %3 us")
+                                 .arg(QTime::currentTime().toString(QLatin1String("hh:mm:ss.zzz")))
+                                 .arg(ExpectResponder::escape(pattern))
+                                 .arg(nsecs / 1000.0, 0, 'f', 1));
+}
+
+void ExpectDialog::load()
+{
+    QSettings settings(SettingsDialog::fileName(), QSettings::IniFormat);
+
+    const int count = settings.beginReadArray(QLatin1String("ExpectRules"));
+    for (int i = 0; i < count; ++i) {
+        settings.setArrayIndex(i);
+        appendRow(settings.value(QLatin1String("Pattern")).toString(),
+                  settings.value(QLatin1String("Response")).toString(),
+                  settings.value(QLatin1String("Delay"), 0).toInt(),
+                  settings.value(QLatin1String("Repeat"), false).toBool());
+    }
+    settings.endArray();
+
+    ui->enabledCheckBox->setChecked(settings.value(QLatin1String("Expect"), false).toBool());
+    applyRules();
+}
+
+void ExpectDialog::save()
+{
+    QSettings settings(SettingsDialog::fileName(), QSettings::IniFormat);
+    settings.setValue(QLatin1String("Expect"), ui->enabledCheckBox->isChecked());
+
+    settings.beginWriteArray(QLatin1String("ExpectRules"));
+    for (int row = 0; row < ui->rulesTable->rowCount(); ++row) {
+        const QTableWidgetItem *delay = ui->rulesTable->item(row, DelayColumn);
+        const QTableWidgetItem *repeat = ui->rulesTable->item(row, RepeatColumn);
+
+        settings.setArrayIndex(row);
+        settings.setValue(QLatin1String("Pattern"), ui->rulesTable->item(row, PatternColumn)->text());
+        settings.setValue(QLatin1String("Response"), ui->rulesTable->item(row, ResponseColumn)->text());
+        settings.setValue(QLatin1String("Delay"), delay->data(Qt::EditRole).toInt());
+        settings.setValue(QLatin1String("Repeat"), Qt::Checked == repeat->checkState());
+    }
+    settings.endArray();
+}
@@ -0,0 +1,55 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef EXPECTDIALOG_H
+#define EXPECTDIALOG_H
+
+#include <QDialog>
+
+QT_BEGIN_NAMESPACE
+
+namespace Ui {
+class ExpectDialog;
+}
+
+QT_END_NAMESPACE
+
+class ExpectResponder;
+
+class ExpectDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit ExpectDialog(ExpectResponder *responder, QWidget *parent = nullptr);
+    ~ExpectDialog();
+
+private slots:
+    void addRule();
+    void removeRule();
+    void applyRules();
+    void logResponse(const QByteArray &pattern, qint64 nsecs);
+
+private:
+    void load();
+    void save();
+    void appendRow(const QString &pattern, const QString &response, int delay, bool repeat);
+
+    Ui::ExpectDialog *ui = nullptr;
+    ExpectResponder *m_responder = nullptr;
+};
+
+#endif // EXPECTDIALOG_H
@@ -0,0 +1,227 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QTimer>
+
+#include "expectresponder.h"
+#include "tracer.h"
+
+ExpectResponder::ExpectResponder(QObject *parent) :
+    QObject(parent)
+{
+    m_clock.start();
+}
+
+void ExpectResponder::setRules(const QVector<Rule> &rules)
+{
+    // Rules that did not change stay fired, editing another one must not
+    // answer a prompt of this session twice.
+    QVector<bool> fired(rules.size(), false);
+    QVector<bool> taken(m_rules.size(), false);
+    for (int i = 0; i < rules.size(); ++i) {
+        for (int j = 0; j < m_rules.size(); ++j) {
+            if (!taken.at(j) && sameRule(rules.at(i), m_rules.at(j))) {
+                fired[i] = m_fired.at(j);
+                taken[j] = true;
+                break;
+            }
+        }
+    }
+
+    // Responses of the old rules still waiting for their delay are dropped.
+    cancelPending();
+
+    m_rules = rules;
+    m_fired = fired;
+    m_matchers.clear();
+    m_tailSize = 0;
+
+    for (const Rule &rule : rules) {
+        m_matchers.append(QByteArrayMatcher(rule.pattern));
+        m_tailSize = qMax(m_tailSize, rule.pattern.size() - 1);
+    }
+
+    if (m_tail.size() > m_tailSize)
+        m_tail.remove(0, m_tail.size() - m_tailSize);
+}
+
+bool ExpectResponder::sameRule(const Rule &a, const Rule &b)
+{
+    return a.pattern == b.pattern && a.response == b.response
+            && a.delay == b.delay && a.repeat == b.repeat;
+}
+
+void ExpectResponder::setEnabled(bool enabled)
+{
+    m_enabled = enabled;
+    if (!enabled)
+        cancelPending();
+}
+
+void ExpectResponder::rearm()
+{
+    cancelPending();
+    m_fired.fill(false, m_rules.size());
+    m_tail.clear();
+}
+
+void ExpectResponder::cancelPending()
+{
+    for (QTimer *timer : m_pending) {
+        timer->stop();
+        timer->deleteLater();
+    }
+    m_pending.clear();
+}
+
+void ExpectResponder::feed(const QByteArray &data)
+{
+    TRACE_SCOPE("ExpectResponder::feed");
+
+    if (!m_enabled || m_rules.isEmpty())
+        return;
+
+    const qint64 arrived = m_clock.nsecsElapsed();
+
+    // A prompt may be split between reads, the end of the previous read is
+    // searched again together with the new one.
+    const QByteArray window = m_tail + data;
+
+    for (int i = 0; i < m_rules.size(); ++i) {
+        const Rule &rule = m_rules.at(i);
+        const int length = rule.pattern.size();
+        if (!length || (m_fired.at(i) && !rule.repeat))
+            continue;
+
+        // Matches lying entirely in the old tail were answered already.
+        int from = qMax(0, m_tail.size() - length + 1);
+        int pos;
+        while ((pos = m_matchers.at(i).indexIn(window, from)) >= 0) {
+            m_fired[i] = true;
+            respond(rule, arrived);
+            if (!rule.repeat)
+                break;
+
+            from = pos + length;
+        }
+    }
+
+    m_tail = window.right(m_tailSize);
+}
+
+void ExpectResponder::respond(const Rule &rule, qint64 arrived)
+{
+    if (rule.delay <= 0) {
+        emit sendData(rule.response);
+        emit responded(rule.pattern, m_clock.nsecsElapsed() - arrived);
+        return;
+    }
+
+    // Kept, so a response can be called off before it goes out.
+    QTimer *timer = new QTimer(this);
+    timer->setSingleShot(true);
+    timer->setTimerType(Qt::PreciseTimer);
+    m_pending.append(timer);
+
+    const QByteArray pattern = rule.pattern;
+    const QByteArray response = rule.response;
+    connect(timer, &QTimer::timeout, this, [this, timer, pattern, response, arrived]() {
+        m_pending.removeOne(timer);
+        timer->deleteLater();
+
+        emit sendData(response);
+        emit responded(pattern, m_clock.nsecsElapsed() - arrived);
+    });
+
+    timer->start(rule.delay);
+}
+
+QByteArray ExpectResponder::unescape(const QString &text)
+{
+    const QByteArray in = text.toUtf8();
+    QByteArray out;
+    out.reserve(in.size());
+
+    for (int i = 0; i < in.size(); ++i) {
+        const char c = in.at(i);
+        if ('\\' != c || i + 1 == in.size()) {
+            out += c;
+            continue;
+        }
+
+        const char e = in.at(++i);
+        switch (e) {
+        case 'r':
+            out += '\r';
+            break;
+        case 'n':
+            out += '\n';
+            break;
+        case 't':
+            out += '\t';
+            break;
+        case 'e':
+            out += '\x1b';
+            break;
+        case 'x': {
+            bool ok = false;
+            const int value = in.mid(i + 1, 2).toInt(&ok, 16);
+            if (ok && i + 2 < in.size()) {
+                out += char(value);
+                i += 2;
+            } else {
+                out += "\\x";
+            }
+            break;
+        }
+        default:
+            out += e;
+            break;
+        }
+    }
+
+    return out;
+}
+
+QString ExpectResponder::escape(const QByteArray &data)
+{
+    QString out;
+    for (const char c : data) {
+        switch (c) {
+        case '\r':
+            out += QLatin1String("\\r");
+            break;
+        case '\n':
+            out += QLatin1String("\\n");
+            break;
+        case '\t':
+            out += QLatin1String("\\t");
+            break;
+        case '\\':
+            out += QLatin1String("\\\\");
+            break;
+        default:
+            if (uchar(c) < 0x20 || 0x7f == uchar(c))
+                out += QStringLiteral("\\x%1").arg(uchar(c), 2, 16, QLatin1Char('0'));
+            else
+                out += QLatin1Char(c);
+            break;
+        }
+    }
+
+    // Everything else was UTF-8 to begin with.
+    return QString::fromUtf8(out.toLatin1());
+}
@@ -0,0 +1,77 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef EXPECTRESPONDER_H
+#define EXPECTRESPONDER_H
+
+#include <QObject>
+#include <QByteArrayMatcher>
+#include <QElapsedTimer>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
+// Answers prompts the moment they arrive. The raw received bytes are searched
+// for the patterns of the rules before anything else is done with them, and
+// the response of a matching rule goes out right away or after its delay.
+class ExpectResponder : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Rule {
+        QByteArray pattern;
+        QByteArray response;
+        int delay = 0;          // milliseconds from the match to the response
+        bool repeat = false;    // answer every match, not only the first one
+    };
+
+    explicit ExpectResponder(QObject *parent = nullptr);
+
+    void setRules(const QVector<Rule> &rules);
+    QVector<Rule> rules() const { return m_rules; }
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+
+    void rearm();
+    void feed(const QByteArray &data);
+
+    static QByteArray unescape(const QString &text);
+    static QString escape(const QByteArray &data);
+
+signals:
+    void sendData(const QByteArray &data);
+    void responded(const QByteArray &pattern, qint64 nsecs);
+
+private:
+    void respond(const Rule &rule, qint64 arrived);
+    void cancelPending();
+    static bool sameRule(const Rule &a, const Rule &b);
+
+    QVector<Rule> m_rules;
+    QVector<QByteArrayMatcher> m_matchers;
+    QVector<bool> m_fired;
+    QVector<QTimer *> m_pending;
+    QByteArray m_tail;
+    QElapsedTimer m_clock;
+    int m_tailSize = 0;
+    bool m_enabled = false;
+};
+
+#endif // EXPECTRESPONDER_H
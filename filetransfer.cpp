@@ -0,0 +1,199 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QDir>
+#include <QFileInfo>
+#include <QIODevice>
+
+#include "filetransfer.h"
+#include "xmodem.h"
+#include "zmodem.h"
+
+namespace {
+
+const char CAN = 0x18;
+const char BS  = 0x08;
+
+quint16 crc16Table[256];
+quint32 crc32Table[256];
+
+bool initTables()
+{
+    for (int i = 0; i < 256; ++i) {
+        quint16 c16 = quint16(i << 8);
+        quint32 c32 = quint32(i);
+        for (int bit = 0; bit < 8; ++bit) {
+            c16 = (c16 & 0x8000) ? quint16((c16 << 1) ^ 0x1021) : quint16(c16 << 1);
+            c32 = (c32 & 1) ? (c32 >> 1) ^ 0xEDB88320 : c32 >> 1;
+        }
+        crc16Table[i] = c16;
+        crc32Table[i] = c32;
+    }
+    return true;
+}
+
+const bool tablesReady = initTables();
+
+} // namespace
+
+FileTransfer::FileTransfer(QIODevice *device, QObject *parent) :
+    QObject(parent),
+    m_device(device)
+{
+    Q_UNUSED(tablesReady);
+
+    m_timeout.setSingleShot(true);
+    connect(&m_timeout, &QTimer::timeout, this, [this]() {
+        if (m_running)
+            timeout();
+    });
+
+    connect(m_device, &QIODevice::bytesWritten, this, [this]() {
+        if (m_running)
+            outputReady();
+    });
+}
+
+FileTransfer *FileTransfer::create(Protocol protocol, QIODevice *device, QObject *parent)
+{
+    switch (protocol) {
+    case XModem1K:
+        return new XModemTransfer(false, device, parent);
+    case YModem:
+        return new XModemTransfer(true, device, parent);
+    case ZModem:
+        return new ZModemTransfer(device, parent);
+    }
+
+    return nullptr;
+}
+
+QStringList FileTransfer::protocolNames()
+{
+    return QStringList() << QLatin1String("XMODEM-1K")
+                         << QLatin1String("YMODEM")
+                         << QLatin1String("ZMODEM");
+}
+
+void FileTransfer::cancel()
+{
+    if (!m_running)
+        return;
+
+    m_cancelled = true;
+    abort(tr("Cancelled"));
+}
+
+void FileTransfer::abandon()
+{
+    if (!m_running)
+        return;
+
+    m_cancelled = true;
+    finish(false, tr("Port lost"));
+}
+
+QString FileTransfer::statistics() const
+{
+    const qint64 msecs = qMax<qint64>(1, m_clock.elapsed());
+    return tr("%1 bytes in %2 s, %3 bytes/s, %4 retries, %5 errors")
+            .arg(m_bytes).arg(msecs / 1000.0, 0, 'f', 2)
+            .arg(m_bytes * 1000 / msecs).arg(m_retries).arg(m_errors);
+}
+
+void FileTransfer::start()
+{
+    m_done = 0;
+    m_total = 0;
+    m_bytes = 0;
+    m_retries = 0;
+    m_errors = 0;
+    m_running = true;
+    m_cancelled = false;
+    m_clock.start();
+}
+
+void FileTransfer::abort(const QString &message)
+{
+    if (!m_running)
+        return;
+
+    // Understood by all the protocols, the backspaces clean up a shell line.
+    write(QByteArray(8, CAN) + QByteArray(8, BS));
+    finish(false, message);
+}
+
+void FileTransfer::finish(bool ok, const QString &message)
+{
+    if (!m_running)
+        return;
+
+    m_running = false;
+    m_timeout.stop();
+
+    if (m_file.isOpen())
+        m_file.close();
+
+    emit finished(ok, message);
+}
+
+void FileTransfer::write(const QByteArray &data)
+{
+    m_device->write(data);
+}
+
+void FileTransfer::restartTimeout(int msecs)
+{
+    m_timeout.start(msecs);
+}
+
+void FileTransfer::addBytes(qint64 bytes)
+{
+    m_bytes += bytes;
+    m_done  += bytes;
+    emit progress(m_done, m_total);
+}
+
+QString FileTransfer::uniqueFileName(const QString &directory, const QString &name)
+{
+    // Only the base name is taken from the remote side.
+    QString base = QFileInfo(name).fileName();
+    if (base.isEmpty() || base.startsWith(QLatin1Char('.')))
+        base.prepend(QLatin1String("received"));
+
+    const QDir dir(directory);
+    QString fileName = dir.filePath(base);
+    for (int i = 1; QFileInfo::exists(fileName); ++i)
+        fileName = dir.filePath(base + QLatin1Char('.') + QString::number(i));
+
+    return fileName;
+}
+
+quint16 FileTransfer::crc16(const char *data, int size, quint16 crc)
+{
+    for (int i = 0; i < size; ++i)
+        crc = quint16((crc << 8) ^ crc16Table[((crc >> 8) ^ uchar(data[i])) & 0xFF]);
+
+    return crc;
+}
+
+quint32 FileTransfer::crc32(const char *data, int size, quint32 crc)
+{
+    for (int i = 0; i < size; ++i)
+        crc = (crc >> 8) ^ crc32Table[(crc ^ uchar(data[i])) & 0xFF];
+
+    return crc;
+}
@@ -0,0 +1,99 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef FILETRANSFER_H
+#define FILETRANSFER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QStringList>
+#include <QTimer>
+
+QT_BEGIN_NAMESPACE
+class QIODevice;
+QT_END_NAMESPACE
+
+// Base of the file transfer protocols. A transfer writes straight into the
+// serial port and is fed with everything read from it while it runs, the
+// console does not see any of that traffic.
+class FileTransfer : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Protocol {
+        XModem1K,
+        YModem,
+        ZModem
+    };
+
+    static FileTransfer *create(Protocol protocol, QIODevice *device, QObject *parent = nullptr);
+    static QStringList protocolNames();
+
+    // Batch protocols receive into a directory, the others into a file.
+    virtual bool isBatch() const = 0;
+
+    virtual void send(const QStringList &fileNames) = 0;
+    virtual void receive(const QString &path) = 0;
+    virtual void feed(const QByteArray &data) = 0;
+
+    void cancel();
+    // Ends the transfer without a word to the peer, for a device that is gone.
+    void abandon();
+    bool isRunning() const { return m_running; }
+    bool isCancelled() const { return m_cancelled; }
+
+    QString statistics() const;
+
+signals:
+    void progress(qint64 done, qint64 total);
+    void finished(bool ok, const QString &message);
+
+protected:
+    FileTransfer(QIODevice *device, QObject *parent);
+
+    void start();
+    void abort(const QString &message);
+    void finish(bool ok, const QString &message);
+    void write(const QByteArray &data);
+    void restartTimeout(int msecs);
+    void addBytes(qint64 bytes);
+
+    virtual void timeout() = 0;
+    virtual void outputReady() {}
+
+    static QString uniqueFileName(const QString &directory, const QString &name);
+    static quint16 crc16(const char *data, int size, quint16 crc = 0);
+    static quint32 crc32(const char *data, int size, quint32 crc = 0xFFFFFFFF);
+
+    QIODevice *m_device = nullptr;
+    QFile m_file;
+    QStringList m_queue;
+    qint64 m_done  = 0;
+    qint64 m_total = 0;
+    int m_retries = 0;
+    int m_errors  = 0;
+
+private:
+    QTimer m_timeout;
+    QElapsedTimer m_clock;
+    qint64 m_bytes = 0;
+    bool m_running = false;
+    bool m_cancelled = false;
+};
+
+#endif // FILETRANSFER_H
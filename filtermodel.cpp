@@ -0,0 +1,282 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QtConcurrent>
+#include <algorithm>
+
+#include "filtermodel.h"
+#include "tracer.h"
+
+namespace {
+
+// Fewer new lines are filtered right away, without going to the thread pool.
+const qint64 ParallelThreshold = 100000;
+
+// Characters of a line shown in a row, the log keeps all of it.
+const int MaxDisplayLength = 1024;
+
+// The lines of one block waiting to be filtered. The block is a shallow copy,
+// the scrollback detaches from it when more text is appended.
+struct Chunk {
+    Scrollback::Block block;
+    int from = 0;
+    int to = 0;
+};
+
+struct Evaluate {
+    typedef QVector<qint64> result_type;
+
+    explicit Evaluate(const LineFilter &f) : filter(f) {}
+
+    QVector<qint64> operator()(const Chunk &chunk) const
+    {
+        TRACE_SCOPE("LineFilter::apply");
+        return filter.apply(chunk.block, chunk.from, chunk.to);
+    }
+
+    LineFilter filter;
+};
+
+} // namespace
+
+bool LineFilter::setPattern(const QString &pattern, bool regex, Qt::CaseSensitivity cs)
+{
+    m_pattern = pattern;
+    m_regex = regex;
+    m_errorString.clear();
+
+    if (regex) {
+        m_expression.setPattern(pattern);
+        m_expression.setPatternOptions(Qt::CaseInsensitive == cs
+                                       ? QRegularExpression::CaseInsensitiveOption
+                                       : QRegularExpression::NoPatternOption);
+        if (!m_expression.isValid()) {
+            m_errorString = m_expression.errorString();
+            m_pattern.clear();
+            return false;
+        }
+
+        // Compile once here rather than in every worker thread.
+        m_expression.optimize();
+    } else {
+        m_matcher.setPattern(pattern);
+        m_matcher.setCaseSensitivity(cs);
+    }
+
+    return true;
+}
+
+QVector<qint64> LineFilter::apply(const Scrollback::Block &block, int from, int to) const
+{
+    if (isEmpty() || from >= to)
+        return QVector<qint64>();
+
+    return m_regex ? applyRegex(block, from, to) : applyLiteral(block, from, to);
+}
+
+QVector<qint64> LineFilter::applyRegex(const Scrollback::Block &block, int from, int to) const
+{
+    QVector<qint64> lines;
+    const QVector<int> &ends = block.lineEnds;
+    const bool include = Include == m_mode;
+
+    for (int line = from; line < to; ++line) {
+        const int start = line ? ends.at(line - 1) + 1 : 0;
+        int end = ends.at(line);
+        if (end > start && QLatin1Char('\r') == block.text.at(end - 1))
+            --end;
+
+        if (include == m_expression.match(block.text.midRef(start, end - start)).hasMatch())
+            lines.append(block.firstLine + line);
+    }
+
+    return lines;
+}
+
+QVector<qint64> LineFilter::applyLiteral(const Scrollback::Block &block, int from, int to) const
+{
+    QVector<qint64> lines;
+    const QVector<int> &ends = block.lineEnds;
+    const int stop = ends.at(to - 1);
+
+    int line = from;
+    int pos = from ? ends.at(from - 1) + 1 : 0;
+
+    while (line < to) {
+        pos = m_matcher.indexIn(block.text.constData(), stop, pos);
+
+        // A hit never spans lines, the pattern has no line ends.
+        const int hit = pos < 0 ? to : int(std::lower_bound(ends.cbegin() + line,
+                                                            ends.cbegin() + to, pos)
+                                           - ends.cbegin());
+        if (Exclude == m_mode) {
+            for (; line < hit; ++line)
+                lines.append(block.firstLine + line);
+        } else if (hit < to) {
+            lines.append(block.firstLine + hit);
+        }
+
+        if (hit >= to)
+            break;
+
+        line = hit + 1;
+        pos = ends.at(hit) + 1;
+    }
+
+    return lines;
+}
+
+FilterModel::FilterModel(const Scrollback *scrollback, QObject *parent) :
+    QAbstractListModel(parent),
+    m_scrollback(scrollback)
+{
+    connect(&m_watcher, &QFutureWatcher<QVector<qint64>>::finished,
+            this, &FilterModel::evaluated);
+}
+
+FilterModel::~FilterModel()
+{
+    m_watcher.cancel();
+    m_watcher.waitForFinished();
+}
+
+void FilterModel::setFilter(const LineFilter &filter)
+{
+    m_watcher.cancel();
+
+    beginResetModel();
+    m_filter = filter;
+    m_lines.clear();
+    m_scanned = 0;
+    endResetModel();
+
+    m_timer.start();
+    update();
+}
+
+void FilterModel::clear()
+{
+    m_watcher.cancel();
+
+    beginResetModel();
+    m_lines.clear();
+    m_scanned = 0;
+    endResetModel();
+}
+
+void FilterModel::update()
+{
+    // A cancelled run calls back here once its threads are done.
+    if (m_filter.isEmpty() || m_watcher.isRunning())
+        return;
+
+    const qint64 total = m_scrollback->completeLineCount();
+    if (total < m_scanned) {
+        clear();
+        return;
+    }
+
+    if (total == m_scanned)
+        return;
+
+    QVector<Chunk> chunks;
+    for (const Scrollback::Block &block : m_scrollback->blocks()) {
+        if (block.firstLine + block.lineEnds.size() <= m_scanned)
+            continue;
+
+        Chunk chunk;
+        chunk.block = block;
+        chunk.from = int(qMax(m_scanned - block.firstLine, qint64(0)));
+        chunk.to = block.lineEnds.size();
+        chunks.append(chunk);
+    }
+
+    m_scanning = total;
+    const Evaluate evaluate(m_filter);
+
+    if (total - m_scanned < ParallelThreshold) {
+        QVector<qint64> lines;
+        for (const Chunk &chunk : chunks)
+            lines += evaluate(chunk);
+
+        scanned(lines);
+        return;
+    }
+
+    m_watcher.setFuture(QtConcurrent::mapped(chunks, evaluate));
+}
+
+void FilterModel::evaluated()
+{
+    if (m_watcher.isCanceled()) {
+        update();
+        return;
+    }
+
+    // The results come in the order of the chunks.
+    QVector<qint64> lines;
+    const QList<QVector<qint64>> parts = m_watcher.future().results();
+    for (const QVector<qint64> &part : parts)
+        lines += part;
+
+    scanned(lines);
+    update();
+}
+
+void FilterModel::scanned(const QVector<qint64> &lines)
+{
+    if (!lines.isEmpty()) {
+        beginInsertRows(QModelIndex(), m_lines.size(), m_lines.size() + lines.size() - 1);
+        m_lines += lines;
+        endInsertRows();
+    }
+
+    m_scanned = m_scanning;
+
+    if (m_timer.isValid()) {
+        emit filtered(m_timer.elapsed());
+        m_timer.invalidate();
+    }
+}
+
+int FilterModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_lines.size();
+}
+
+QVariant FilterModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_lines.size())
+        return QVariant();
+
+    const qint64 line = m_lines.at(index.row());
+
+    if (Qt::DisplayRole == role) {
+        QString text = m_scrollback->line(line, MaxDisplayLength + 1);
+        if (text.size() > MaxDisplayLength) {
+            text.truncate(MaxDisplayLength);
+            text += QChar(0x2026);
+        } else if (text.endsWith(QLatin1Char('\r'))) {
+            text.chop(1);
+        }
+        return text;
+    }
+
+    if (Qt::ToolTipRole == role)
+        return tr("Line %1").arg(line + 1);
+
+    return QVariant();
+}
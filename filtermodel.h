@@ -0,0 +1,104 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef FILTERMODEL_H
+#define FILTERMODEL_H
+
+#include <QAbstractListModel>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QRegularExpression>
+#include <QStringMatcher>
+
+#include "scrollback.h"
+
+// Decides which lines of the scrollback pass. A literal pattern is searched
+// in the whole block text and the hits are mapped to lines, so lines that do
+// not contain it cost nothing beyond the search itself.
+class LineFilter
+{
+public:
+    enum Mode {
+        Include,
+        Exclude
+    };
+
+    bool setPattern(const QString &pattern, bool regex, Qt::CaseSensitivity cs);
+    void setMode(Mode mode) { m_mode = mode; }
+
+    QString pattern() const { return m_pattern; }
+    Mode mode() const { return m_mode; }
+    bool isEmpty() const { return m_pattern.isEmpty(); }
+    QString errorString() const { return m_errorString; }
+
+    // Numbers of the passing lines among the lines [from, to) of the block.
+    // A line longer than a block is judged by its part in the block where
+    // it ends.
+    QVector<qint64> apply(const Scrollback::Block &block, int from, int to) const;
+
+private:
+    QVector<qint64> applyRegex(const Scrollback::Block &block, int from, int to) const;
+    QVector<qint64> applyLiteral(const Scrollback::Block &block, int from, int to) const;
+
+    QString m_pattern;
+    QString m_errorString;
+    QRegularExpression m_expression;
+    QStringMatcher m_matcher;
+    Mode m_mode = Include;
+    bool m_regex = false;
+};
+
+// The lines of the scrollback passing a filter. Only line numbers are kept,
+// the text is fetched from the scrollback when a row is shown.
+class FilterModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    explicit FilterModel(const Scrollback *scrollback, QObject *parent = nullptr);
+    ~FilterModel() Q_DECL_OVERRIDE;
+
+    void setFilter(const LineFilter &filter);
+    const LineFilter &filter() const { return m_filter; }
+
+    bool isBusy() const { return m_watcher.isRunning(); }
+    qint64 scannedLines() const { return m_scanned; }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const Q_DECL_OVERRIDE;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const Q_DECL_OVERRIDE;
+
+public slots:
+    void update();
+    void clear();
+
+signals:
+    void filtered(qint64 msecs);
+
+private:
+    void evaluated();
+    void scanned(const QVector<qint64> &lines);
+
+    const Scrollback *m_scrollback = nullptr;
+    LineFilter m_filter;
+    QVector<qint64> m_lines;
+    qint64 m_scanned  = 0;
+    qint64 m_scanning = 0;
+
+    QFutureWatcher<QVector<qint64>> m_watcher;
+    QElapsedTimer m_timer;
+};
+
+#endif // FILTERMODEL_H
@@ -0,0 +1,170 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QListView>
+#include <QScrollBar>
+#include <QVBoxLayout>
+
+#include "filtermodel.h"
+#include "filterview.h"
+
+namespace {
+
+const int RefreshInterval = 250;
+
+// Pause after the last key press before the filter is applied.
+const int EditDelay = 300;
+
+} // namespace
+
+FilterView::FilterView(const Scrollback *scrollback, QWidget *parent) :
+    QWidget(parent),
+    m_scrollback(scrollback),
+    m_model(new FilterModel(scrollback, this))
+{
+    m_patternEdit = new QLineEdit(this);
+    m_patternEdit->setPlaceholderText(tr("Filter"));
+    m_patternEdit->setClearButtonEnabled(true);
+
+    m_modeBox = new QComboBox(this);
+    m_modeBox->addItem(tr("Include"), LineFilter::Include);
+    m_modeBox->addItem(tr("Exclude"), LineFilter::Exclude);
+
+    m_regexCheckBox = new QCheckBox(tr("Regular expression"), this);
+    m_caseCheckBox = new QCheckBox(tr("Match case"), this);
+    m_caseCheckBox->setChecked(true);
+
+    m_listView = new QListView(this);
+    m_listView->setModel(m_model);
+    m_listView->setUniformItemSizes(true);
+    m_listView->setSelectionMode(QAbstractItemView::ExtendedSelection);
+
+    QPalette p = m_listView->palette();
+    p.setColor(QPalette::Base, Qt::black);
+    p.setColor(QPalette::Text, Qt::green);
+    m_listView->setPalette(p);
+
+    m_summaryLabel = new QLabel(this);
+
+    QHBoxLayout *options = new QHBoxLayout;
+    options->addWidget(m_patternEdit, 1);
+    options->addWidget(m_modeBox);
+    options->addWidget(m_regexCheckBox);
+    options->addWidget(m_caseCheckBox);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addLayout(options);
+    layout->addWidget(m_listView, 1);
+    layout->addWidget(m_summaryLabel);
+
+    m_editTimer.setSingleShot(true);
+    connect(&m_editTimer, &QTimer::timeout, this, &FilterView::applyFilter);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &FilterView::refresh);
+
+    connect(m_patternEdit, &QLineEdit::textChanged, [this]() { m_editTimer.start(EditDelay); });
+    connect(m_patternEdit, &QLineEdit::returnPressed, this, &FilterView::applyFilter);
+    connect(m_modeBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
+            this, &FilterView::applyFilter);
+    connect(m_regexCheckBox, &QCheckBox::toggled, this, &FilterView::applyFilter);
+    connect(m_caseCheckBox, &QCheckBox::toggled, this, &FilterView::applyFilter);
+
+    // New matches keep the view at the bottom unless the user scrolled up.
+    connect(m_model, &FilterModel::rowsAboutToBeInserted, [this]() {
+        const QScrollBar *bar = m_listView->verticalScrollBar();
+        m_follow = bar->value() == bar->maximum();
+    });
+    connect(m_model, &FilterModel::rowsInserted, [this]() {
+        if (m_follow)
+            m_listView->scrollToBottom();
+    });
+    connect(m_model, &FilterModel::filtered, [this](qint64 msecs) {
+        m_msecs = msecs;
+        updateSummary();
+    });
+
+    updateSummary();
+}
+
+void FilterView::clear()
+{
+    m_model->clear();
+    updateSummary();
+}
+
+void FilterView::applyFilter()
+{
+    m_editTimer.stop();
+
+    LineFilter filter;
+    filter.setMode(static_cast<LineFilter::Mode>(m_modeBox->currentData().toInt()));
+    if (filter.setPattern(m_patternEdit->text(), m_regexCheckBox->isChecked(),
+                          m_caseCheckBox->isChecked() ? Qt::CaseSensitive : Qt::CaseInsensitive))
+        m_errorString.clear();
+    else
+        m_errorString = filter.errorString();
+
+    m_msecs = -1;
+    m_follow = true;
+    m_model->setFilter(filter);
+    updateSummary();
+}
+
+void FilterView::refresh()
+{
+    m_model->update();
+    updateSummary();
+}
+
+void FilterView::updateSummary()
+{
+    if (!m_errorString.isEmpty()) {
+        m_summaryLabel->setText(tr("Invalid pattern: %1").arg(m_errorString));
+        return;
+    }
+
+    if (m_model->filter().isEmpty()) {
+        m_summaryLabel->setText(tr("Type a pattern to show the matching lines only"));
+        return;
+    }
+
+    QString text = m_model->isBusy()
+            ? tr("Filtering %1 lines...").arg(m_scrollback->completeLineCount())
+            : tr("%1 of %2 lines").arg(m_model->rowCount()).arg(m_model->scannedLines());
+
+    if (m_msecs >= 0)
+        text += tr(", filtered in %1 ms").arg(m_msecs);
+
+    m_summaryLabel->setText(text);
+}
+
+void FilterView::showEvent(QShowEvent *e)
+{
+    m_refreshTimer.start(RefreshInterval);
+    refresh();
+    QWidget::showEvent(e);
+}
+
+void FilterView::hideEvent(QHideEvent *e)
+{
+    m_refreshTimer.stop();
+    QWidget::hideEvent(e);
+}
@@ -0,0 +1,70 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef FILTERVIEW_H
+#define FILTERVIEW_H
+
+#include <QWidget>
+#include <QTimer>
+
+QT_BEGIN_NAMESPACE
+class QCheckBox;
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QListView;
+QT_END_NAMESPACE
+
+class FilterModel;
+class Scrollback;
+
+class FilterView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit FilterView(const Scrollback *scrollback, QWidget *parent = nullptr);
+
+public slots:
+    void clear();
+
+protected:
+    void showEvent(QShowEvent *e) Q_DECL_OVERRIDE;
+    void hideEvent(QHideEvent *e) Q_DECL_OVERRIDE;
+
+private:
+    void applyFilter();
+    void refresh();
+    void updateSummary();
+
+    const Scrollback *m_scrollback = nullptr;
+    FilterModel *m_model = nullptr;
+
+    QLineEdit *m_patternEdit   = nullptr;
+    QComboBox *m_modeBox       = nullptr;
+    QCheckBox *m_regexCheckBox = nullptr;
+    QCheckBox *m_caseCheckBox  = nullptr;
+    QListView *m_listView      = nullptr;
+    QLabel    *m_summaryLabel  = nullptr;
+
+    QTimer m_refreshTimer;
+    QTimer m_editTimer;
+    QString m_errorString;
+    qint64 m_msecs = -1;
+    bool m_follow = true;
+};
+
+#endif // FILTERVIEW_H
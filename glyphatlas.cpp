@@ -0,0 +1,122 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QFontMetrics>
+#include <QPainter>
+#include <QVarLengthArray>
+
+#include "glyphatlas.h"
+
+namespace {
+
+// Cells per page in each direction.
+const int PageCells = 32;
+
+// Past that many glyphs the atlas starts over rather than keep growing.
+const int MaxGlyphs = 8 * PageCells * PageCells;
+
+} // namespace
+
+void GlyphAtlas::setFont(const QFont &font, qreal devicePixelRatio)
+{
+    m_font = font;
+    m_devicePixelRatio = devicePixelRatio;
+
+    const QFontMetrics metrics(font);
+    m_cell = QSize(metrics.horizontalAdvance(QLatin1Char('M')), metrics.height());
+    m_ascent = metrics.ascent();
+
+    clear();
+}
+
+void GlyphAtlas::clear()
+{
+    m_glyphs.clear();
+    m_pages.clear();
+}
+
+const GlyphAtlas::Glyph &GlyphAtlas::glyph(QChar c, QRgb color)
+{
+    const quint64 key = (quint64(color) << 16) | c.unicode();
+    auto it = m_glyphs.constFind(key);
+    if (it != m_glyphs.cend())
+        return *it;
+
+    const int index = m_glyphs.size();
+    const int page = index / (PageCells * PageCells);
+    const int cell = index % (PageCells * PageCells);
+
+    if (page == m_pages.size()) {
+        QPixmap pixmap(m_cell * PageCells * m_devicePixelRatio);
+        pixmap.setDevicePixelRatio(m_devicePixelRatio);
+        pixmap.fill(Qt::transparent);
+        m_pages.append(pixmap);
+    }
+
+    const QRect rect(QPoint(cell % PageCells * m_cell.width(),
+                            cell / PageCells * m_cell.height()), m_cell);
+
+    QPainter painter(&m_pages[page]);
+    painter.setFont(m_font);
+    painter.setPen(QColor::fromRgba(color));
+    painter.setClipRect(rect);
+    painter.drawText(rect.left(), rect.top() + m_ascent, QString(c));
+
+    Glyph g;
+    g.page = page;
+    g.source = QRectF(QPointF(rect.topLeft()) * m_devicePixelRatio,
+                      QSizeF(rect.size()) * m_devicePixelRatio);
+
+    return *m_glyphs.insert(key, g);
+}
+
+void GlyphAtlas::draw(QPainter *painter, const QPoint &topLeft, const QChar *text, int count,
+                      QRgb color)
+{
+    if (m_glyphs.size() > MaxGlyphs)
+        clear();
+
+    const qreal scale = 1 / m_devicePixelRatio;
+    const qreal y = topLeft.y() + m_cell.height() / 2.0;
+
+    QVarLengthArray<QPainter::PixmapFragment, 256> fragments;
+    int page = -1;
+
+    auto flush = [&]() {
+        if (!fragments.isEmpty())
+            painter->drawPixmapFragments(fragments.constData(), fragments.size(),
+                                         m_pages.at(page));
+        fragments.clear();
+    };
+
+    for (int i = 0; i < count; ++i) {
+        const QChar c = text[i];
+        if (c.isSpace() || c.isSurrogate())
+            continue;
+
+        const Glyph &g = glyph(c, color);
+        if (g.page != page) {
+            flush();
+            page = g.page;
+        }
+
+        // Fragments are placed by their centre.
+        const qreal x = topLeft.x() + (i + 0.5) * m_cell.width();
+        fragments.append(QPainter::PixmapFragment::create(QPointF(x, y), g.source, scale, scale));
+    }
+
+    flush();
+}
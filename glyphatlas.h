@@ -0,0 +1,59 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <QFont>
+#include <QHash>
+#include <QPixmap>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QPainter;
+QT_END_NAMESPACE
+
+// Glyphs of a fixed width font rendered once into a few large pixmaps. A run
+// of text is drawn as a batch of fragments of those pixmaps, so drawing a
+// row does no text shaping or layout at all.
+class GlyphAtlas
+{
+public:
+    void setFont(const QFont &font, qreal devicePixelRatio);
+    QSize cellSize() const { return m_cell; }
+    qreal devicePixelRatio() const { return m_devicePixelRatio; }
+
+    void draw(QPainter *painter, const QPoint &topLeft, const QChar *text, int count,
+              QRgb color);
+    void clear();
+
+private:
+    struct Glyph {
+        int page = 0;
+        QRectF source;
+    };
+
+    const Glyph &glyph(QChar c, QRgb color);
+
+    QFont  m_font;
+    QSize  m_cell;
+    int    m_ascent = 0;
+    qreal  m_devicePixelRatio = 1;
+    QHash<quint64, Glyph> m_glyphs;
+    QVector<QPixmap> m_pages;
+};
+
+#endif // GLYPHATLAS_H
@@ -0,0 +1,67 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QFontDatabase>
+
+#include "latencydialog.h"
+#include "latencyprobe.h"
+#include "ui_latencydialog.h"
+
+LatencyDialog::LatencyDialog(LatencyProbe *probe, QWidget *parent) :
+    QDialog(parent),
+    ui(new Ui::LatencyDialog),
+    m_probe(probe)
+{
+    ui->setupUi(this);
+    ui->reportEdit->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+    connect(ui->startButton, &QPushButton::clicked, this, &LatencyDialog::toggle);
+    connect(m_probe, &LatencyProbe::finished, this, &LatencyDialog::finish);
+    connect(&m_reportTimer, &QTimer::timeout, this, &LatencyDialog::updateReport);
+}
+
+LatencyDialog::~LatencyDialog()
+{
+    delete ui;
+}
+
+void LatencyDialog::toggle()
+{
+    if (m_probe->isRunning()) {
+        m_probe->stop();
+        return;
+    }
+
+    ui->startButton->setText(tr("Stop"));
+    ui->parametersBox->setEnabled(false);
+
+    m_probe->start(ui->rateBox->value(), ui->sizeBox->value(), ui->countBox->value());
+    m_reportTimer.start(250);
+}
+
+void LatencyDialog::updateReport()
+{
+    ui->reportEdit->setPlainText(m_probe->report());
+}
+
+void LatencyDialog::finish()
+{
+    m_reportTimer.stop();
+    updateReport();
+
+    ui->startButton->setText(tr("Start"));
+    ui->parametersBox->setEnabled(true);
+}
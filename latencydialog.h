@@ -0,0 +1,52 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef LATENCYDIALOG_H
+#define LATENCYDIALOG_H
+
+#include <QDialog>
+#include <QTimer>
+
+QT_BEGIN_NAMESPACE
+
+namespace Ui {
+class LatencyDialog;
+}
+
+QT_END_NAMESPACE
+
+class LatencyProbe;
+
+class LatencyDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit LatencyDialog(LatencyProbe *probe, QWidget *parent = nullptr);
+    ~LatencyDialog();
+
+private slots:
+    void toggle();
+    void updateReport();
+    void finish();
+
+private:
+    Ui::LatencyDialog *ui = nullptr;
+    LatencyProbe *m_probe = nullptr;
+    QTimer m_reportTimer;
+};
+
+#endif // LATENCYDIALOG_H
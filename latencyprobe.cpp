@@ -0,0 +1,201 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QStringList>
+#include <algorithm>
+
+#include "latencyprobe.h"
+
+namespace {
+
+// A probe is "#LAT" + 8 hex digits of the sequence number + "#", padded
+// with dots up to the payload size and terminated by a new line.
+const char Marker[] = "#LAT";
+const int MarkerLength = 4;
+const int HeaderLength = MarkerLength + 9;
+
+// A probe that is not back within that time is counted as lost.
+const qint64 Timeout = 1000000000;
+
+} // namespace
+
+LatencyProbe::LatencyProbe(QObject *parent) :
+    QObject(parent)
+{
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &LatencyProbe::sendDue);
+}
+
+void LatencyProbe::start(int rate, int payloadSize, int count)
+{
+    m_inFlight.clear();
+    m_samples.clear();
+    m_samples.reserve(count);
+    m_rx.clear();
+    m_payloadSize = qMax(payloadSize, HeaderLength + 1);
+    m_count = count;
+    m_sent  = 0;
+    m_lost  = 0;
+
+    // The timer only wakes the probe up, the probes are due by the clock.
+    // A rate that does not divide a millisecond, or is above one per
+    // millisecond, comes out right on average.
+    m_interval = 1000000000 / qMax(1, rate);
+    m_due = 0;
+
+    m_clock.start();
+    m_timer.start(int(qMax<qint64>(1, m_interval / 1000000)));
+    sendDue();
+}
+
+void LatencyProbe::stop()
+{
+    if (!m_timer.isActive())
+        return;
+
+    m_timer.stop();
+    m_lost += m_inFlight.size();
+    m_inFlight.clear();
+    emit finished();
+}
+
+bool LatencyProbe::isRunning() const
+{
+    return m_timer.isActive();
+}
+
+void LatencyProbe::feed(const QByteArray &data)
+{
+    if (!isRunning())
+        return;
+
+    const qint64 now = m_clock.nsecsElapsed();
+    m_rx.append(data);
+
+    int pos;
+    while ((pos = m_rx.indexOf(Marker)) >= 0) {
+        if (m_rx.size() < pos + HeaderLength) {
+            m_rx.remove(0, pos);
+            return;
+        }
+
+        bool ok = false;
+        const quint32 sequence = m_rx.mid(pos + MarkerLength, 8).toUInt(&ok, 16);
+        if (ok && '#' == m_rx.at(pos + HeaderLength - 1)) {
+            auto it = m_inFlight.find(sequence);
+            if (it != m_inFlight.end()) {
+                m_samples.append(now - it.value());
+                m_inFlight.erase(it);
+            }
+        }
+
+        m_rx.remove(0, pos + MarkerLength);
+    }
+
+    if (m_rx.size() >= MarkerLength)
+        m_rx.remove(0, m_rx.size() - MarkerLength + 1);
+
+    if (m_sent == m_count && m_inFlight.isEmpty())
+        stop();
+}
+
+void LatencyProbe::sendDue()
+{
+    const qint64 now = m_clock.nsecsElapsed();
+    expire(now);
+
+    while (isRunning() && m_sent < m_count && m_due <= now) {
+        sendProbe();
+        m_due += m_interval;
+    }
+
+    if (isRunning() && m_sent == m_count && m_inFlight.isEmpty())
+        stop();
+}
+
+void LatencyProbe::sendProbe()
+{
+    QByteArray probe = Marker + QByteArray::number(m_sequence, 16).rightJustified(8, '0') + '#';
+    probe = probe.leftJustified(m_payloadSize - 1, '.');
+    probe.append('\n');
+
+    m_inFlight.insert(m_sequence++, m_clock.nsecsElapsed());
+    ++m_sent;
+    emit sendData(probe);
+}
+
+void LatencyProbe::expire(qint64 now)
+{
+    for (auto it = m_inFlight.begin(); it != m_inFlight.end();) {
+        if (now - it.value() > Timeout) {
+            it = m_inFlight.erase(it);
+            ++m_lost;
+        } else {
+            ++it;
+        }
+    }
+}
+
+QString LatencyProbe::report() const
+{
+    QStringList lines;
+    lines << tr("Sent: %1, received: %2, lost: %3, in flight: %4")
+             .arg(m_sent).arg(m_samples.size()).arg(m_lost).arg(m_inFlight.size());
+
+    if (m_samples.isEmpty())
+        return lines.join(QLatin1Char('\n'));
+
+    QVector<qint64> sorted = m_samples;
+    std::sort(sorted.begin(), sorted.end());
+
+    qint64 sum = 0;
+    for (qint64 sample : sorted)
+        sum += sample;
+
+    auto percentile = [&sorted](int p) {
+        return sorted.at(int((qint64(sorted.size()) - 1) * p / 100));
+    };
+    auto us = [](qint64 ns) { return QString::number(ns / 1000.0, 'f', 1); };
+
+    lines << tr("min %1 us, avg %2 us, p50 %3 us, p99 %4 us, max %5 us")
+             .arg(us(sorted.first())).arg(us(sum / sorted.size()))
+             .arg(us(percentile(50))).arg(us(percentile(99))).arg(us(sorted.last()));
+    lines << QString();
+
+    // Power of two buckets in microseconds.
+    QVector<int> histogram;
+    for (qint64 sample : sorted) {
+        int bucket = 0;
+        for (qint64 v = sample / 1000; v > 1; v >>= 1)
+            ++bucket;
+        if (histogram.size() <= bucket)
+            histogram.resize(bucket + 1);
+        ++histogram[bucket];
+    }
+
+    const int peak = *std::max_element(histogram.cbegin(), histogram.cend());
+    for (int i = 0; i < histogram.size(); ++i) {
+        if (!histogram.at(i))
+            continue;
+
+        lines << QStringLiteral("< %1 us %2 %3")
+                 .arg(QString::number(qint64(1) << (i + 1)), 9)
+                 .arg(histogram.at(i), 7)
+                 .arg(QString(histogram.at(i) * 40 / peak + 1, QLatin1Char('#')));
+    }
+
+    return lines.join(QLatin1Char('\n'));
+}
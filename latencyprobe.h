@@ -0,0 +1,69 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef LATENCYPROBE_H
+#define LATENCYPROBE_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QTimer>
+#include <QVector>
+
+// Measures the round trip time of the link. Numbered probes are sent at a
+// fixed rate and recognized again in the received data, which works with a
+// loopback plug or any device that echoes its input.
+class LatencyProbe : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit LatencyProbe(QObject *parent = nullptr);
+
+    void start(int rate, int payloadSize, int count);
+    void stop();
+    bool isRunning() const;
+
+    void feed(const QByteArray &data);
+
+    QString report() const;
+
+signals:
+    void sendData(const QByteArray &data);
+    void finished();
+
+private slots:
+    void sendDue();
+
+private:
+    void sendProbe();
+    void expire(qint64 now);
+
+    QElapsedTimer m_clock;
+    QTimer m_timer;
+    QHash<quint32, qint64> m_inFlight;
+    QVector<qint64> m_samples;
+    QByteArray m_rx;
+    qint64 m_interval = 0;
+    qint64 m_due = 0;
+    quint32 m_sequence = 0;
+    int m_payloadSize = 0;
+    int m_count = 0;
+    int m_sent  = 0;
+    int m_lost  = 0;
+};
+
+#endif // LATENCYPROBE_H
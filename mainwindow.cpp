@@ -35,26 +35,58 @@
 #include <QMessageBox>
 #include <QLabel>
 #include <QtSerialPort/QSerialPort>
+#include <QtSerialPort/QSerialPortInfo>
 #include <QTextCodec>
-#include <QTextStream>
 #include <QFile>
 #include <QDir>
+#include <QFileInfo>
 #include <QDate>
 #include <QTime>
 #include <QFileDialog>
+#include <QInputDialog>
+#include <QProgressDialog>
+#include <QDockWidget>
+#include <QElapsedTimer>
 #include <QCoreApplication>
 
 #include "ui_mainwindow.h"
+#include "bulksender.h"
 #include "console.h"
+#include "expectdialog.h"
+#include "expectresponder.h"
+#include "filetransfer.h"
+#include "filterview.h"
+#include "latencydialog.h"
+#include "latencyprobe.h"
+#include "plotwidget.h"
+#include "reconnector.h"
+#include "serialbridge.h"
 #include "settingsdialog.h"
+#include "tracer.h"
 #include "mainwindow.h"
 
+namespace {
+
+// Received text shown as a sample while the display is overloaded.
+const int SampleSize = 2048;
+
+// How often the overloaded display is refreshed, milliseconds.
+const int SummaryInterval = 500;
+
+} // namespace
+
 //! [0]
 MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent),
-    ui(new Ui::MainWindow)
+    ui(new Ui::MainWindow),
+    m_extractor(&m_samples)
 {
     //! [0]
     serial = new QSerialPort(this);
+    bridge = new SerialBridge(this);
+    latency = new LatencyProbe(this);
+    reconnector = new Reconnector(serial, this);
+    responder = new ExpectResponder(this);
+    bulk = new BulkSender(serial, this);
 
     //! [1]
     ui->setupUi(this);
@@ -63,7 +95,26 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent),
     console->setFocus();
 
     //! [1]
+    plot = new PlotWidget(&m_samples, this);
+    plotDock = new QDockWidget(tr("Plot"), this);
+    plotDock->setObjectName(QLatin1String("plotDock"));
+    plotDock->setWidget(plot);
+    addDockWidget(Qt::BottomDockWidgetArea, plotDock);
+    plotDock->hide();
+
+    filterView = new FilterView(&m_scrollback, this);
+    filterDock = new QDockWidget(tr("Filter"), this);
+    filterDock->setObjectName(QLatin1String("filterDock"));
+    filterDock->setWidget(filterView);
+    addDockWidget(Qt::RightDockWidgetArea, filterDock);
+    filterDock->hide();
+
     settings = new SettingsDialog(this);
+    latencyDialog = new LatencyDialog(latency, this);
+    expectDialog = new ExpectDialog(responder, this);
+
+    status = new QLabel(this);
+    ui->statusBar->addPermanentWidget(status);
 
     ui->actionOpen->setEnabled(true);
     ui->actionSave->setEnabled(true);
@@ -72,6 +123,9 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent),
     ui->actionDisconnect->setEnabled(false);
     ui->actionQuit->setEnabled(true);
     ui->actionConfigure->setEnabled(true);
+    ui->actionLatency->setEnabled(false);
+    ui->actionSendFile->setEnabled(false);
+    ui->actionReceiveFile->setEnabled(false);
 
     initActionsConnections();
 
@@ -82,21 +136,49 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent),
     connect(serial, &QSerialPort::readyRead, this, &MainWindow::readData);
     //! [2]
     connect(console, &Console::getData, this, &MainWindow::writeData);
+    connect(console, &Console::pasteData, this, &MainWindow::sendText);
+    connect(console, &Console::dropFiles, this, &MainWindow::sendFiles);
     //! [3]
+    connect(bridge, &SerialBridge::dataReceived, this, &MainWindow::writeData);
+    connect(bridge, &SerialBridge::clientsChanged, this, &MainWindow::updateBridgeStatus);
+    connect(bridge, &SerialBridge::listenFailed, [this](const QString &errorString) {
+        QMessageBox::warning(this, tr("Warning!"), tr("Could not share the port:\n%1").arg(errorString));
+        updateBridgeStatus();
+    });
+    connect(reconnector, &Reconnector::reconnected, this, &MainWindow::portRestored);
+
+    connect(latency, &LatencyProbe::sendData, this, &MainWindow::sendNow);
+    connect(responder, &ExpectResponder::sendData, this, &MainWindow::sendNow);
+    connect(responder, &ExpectResponder::responded, [this](const QByteArray &pattern, qint64 nsecs) {
+        showStatusMessage(tr("Answered \"%1\" in %2 us").arg(ExpectResponder::escape(pattern))
+                          .arg(nsecs / 1000.0, 0, 'f', 1));
+    });
+
+    connect(bulk, &BulkSender::finished, this, &MainWindow::bulkFinished);
+    connect(bulk, &BulkSender::progress, [this](qint64 done, qint64 total) {
+        if (bulkProgress && total > 0)
+            bulkProgress->setValue(int(qMin(done, total) * 100 / total));
+        echoSent(done);
+    });
 
     m_readTimer.setSingleShot(true);
     connect(&m_readTimer, &QTimer::timeout, this, &MainWindow::flushBuffer);
+
+    m_summaryTimer.setSingleShot(true);
+    connect(&m_summaryTimer, &QTimer::timeout, this, &MainWindow::showSkipSummary);
 }
 //! [3]
 
 MainWindow::~MainWindow()
 {
-    if (saveFileOnExit && !console->toPlainText().isEmpty())
+    if (saveFileOnExit && !m_scrollback.isEmpty())
         writeToFile(QCoreApplication::applicationDirPath() + QDir::separator() +
                     QDate::currentDate().toString("yyyy-MM-dd") + QLatin1Char(' ') +
                     QTime::currentTime().toString("hh-mm-ss") + QLatin1String(".log"));
 
     settings->deleteLater();
+    delete decoder;
+    delete echoDecoder;
     delete ui;
 }
 
@@ -113,9 +195,28 @@ void MainWindow::openSerialPort()
     serial->setReadBufferSize(10000);
 
     codec = QTextCodec::codecForName(p.textEncoding.toLatin1());
+
+    // A character may be split between two reads, the decoder keeps the
+    // start of it for the next one.
+    delete decoder;
+    decoder = codec->makeDecoder();
     saveFileOnExit = p.saveOnExit;
+    autoReconnect = p.reconnect;
+
+    m_extractor.setPatterns(p.plotPatterns);
+    m_extractor.reset();
+    m_overload.reset();
+    responder->rearm();
+    bulk->setPacing(p.pastePacing, p.pasteDelay, ExpectResponder::unescape(p.pastePrompt));
+
+    m_sanitizer.setMaxLineLength(p.maxLineLength);
+    m_sanitizer.setControlChars(p.controlChars);
+    m_sanitizer.reset();
 
     if (serial->open(QIODevice::ReadWrite)) {
+        // Remembered now, it cannot be looked up once the device is gone.
+        m_portLocation = QSerialPortInfo(*serial).systemLocation();
+
         console->setFocus();
         console->setLocalEchoEnabled(p.localEchoEnabled);
         serial->setDataTerminalReady(p.dtrEnabled);
@@ -124,10 +225,18 @@ void MainWindow::openSerialPort()
         ui->actionConnect->setEnabled(false);
         ui->actionDisconnect->setEnabled(true);
         ui->actionConfigure->setEnabled(false);
+        ui->actionLatency->setEnabled(true);
+        ui->actionSendFile->setEnabled(true);
+        ui->actionReceiveFile->setEnabled(true);
 
         showStatusMessage(tr("Connected to %1 : %2, %3, %4, %5, %6")
                           .arg(p.name).arg(p.stringBaudRate).arg(p.stringDataBits)
                           .arg(p.stringParity).arg(p.stringStopBits).arg(p.stringFlowControl));
+
+        if (p.bridgeEnabled && !bridge->listen(p.bridgePort, p.bridgeRemote, p.bridgeSocketName))
+            QMessageBox::warning(this, tr("Warning!"),
+                                 tr("Could not share the port:\n%1").arg(bridge->errorString()));
+        updateBridgeStatus();
     } else {
         QMessageBox::critical(this, tr("Error"), serial->errorString());
         showStatusMessage(tr("Open error"));
@@ -138,12 +247,26 @@ void MainWindow::openSerialPort()
 //! [5]
 void MainWindow::closeSerialPort()
 {
+    reconnector->stop();
+
+    if (transfer)
+        transfer->cancel();
+
+    bulk->cancel();
+
     if (serial->isOpen())
         serial->close();
 
+    bridge->close();
+    updateBridgeStatus();
+    latency->stop();
+
     ui->actionConnect->setEnabled(true);
     ui->actionDisconnect->setEnabled(false);
     ui->actionConfigure->setEnabled(true);
+    ui->actionLatency->setEnabled(false);
+    ui->actionSendFile->setEnabled(false);
+    ui->actionReceiveFile->setEnabled(false);
 
     showStatusMessage(tr("Disconnected"));
 }
@@ -158,9 +281,29 @@ void MainWindow::about()
                           "<center>seryoga.engineering@gmail.com</center>"));
 }
 
+// Probes and automatic answers are pushed out at once, without waiting for
+// the event loop, so their timing stays accurate.
+void MainWindow::sendNow(const QByteArray &data)
+{
+    if (serial->isOpen()) {
+        serial->write(data);
+        serial->flush();
+    }
+}
+
 //! [6]
 void MainWindow::writeData(const QByteArray &data)
 {
+    // Nothing may get in the way of a running file transfer.
+    if (transfer)
+        return;
+
+    // Typing during a paste is sent after it, not in the middle of a line.
+    if (bulk->isRunning()) {
+        bulk->send(data);
+        return;
+    }
+
     if (serial->isOpen())
         serial->write(data);
 }
@@ -169,39 +312,227 @@ void MainWindow::writeData(const QByteArray &data)
 //! [7]
 void MainWindow::readData()
 {
+    TRACE_SCOPE("MainWindow::readData");
+
+    const QByteArray data = serial->readAll();
+    if (transfer) {
+        transfer->feed(data);
+        return;
+    }
+
+    // Prompts are answered before the data goes anywhere else.
+    responder->feed(data);
+    bulk->feed(data);
+    latency->feed(data);
+    bridge->broadcast(data);
+
+    QString decoded;
+    {
+        TRACE_SCOPE("QTextCodec::toUnicode");
+        decoded = decoder->toUnicode(data);
+    }
+
+    // The log keeps what the device sent, only the display is wrapped and
+    // cleaned.
+    m_scrollback.append(decoded);
+    m_overload.received(decoded.size());
+
+    // Values are extracted as soon as they arrive, the console may be busy.
+    if (ui->actionPlot->isChecked())
+        m_extractor.feed(decoded);
+
+    m_rxText += m_sanitizer.process(decoded);
     flushBuffer();
 }
 //! [7]
 
 void MainWindow::flushBuffer()
 {
+    TRACE_SCOPE("MainWindow::flushBuffer");
+
     if (console->isBusy()) {
         m_readTimer.start(100);
         return;
     }
 
-    console->putData(codec->toUnicode(serial->readAll()));
+    if (m_rxText.isEmpty())
+        return;
+
+    // Everything is already in the scrollback, the display may fall behind.
+    if (!m_overload.canRender(m_rxText.size())) {
+        skipBuffer();
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    console->putData(m_rxText);
+    m_rxText.clear();
+
+    m_overload.rendered(timer.elapsed());
+}
+
+void MainWindow::skipBuffer()
+{
+    m_skippedLines += m_rxText.count(QLatin1Char('\n'));
+    m_skippedChars += m_rxText.size();
+
+    m_rxSample += m_rxText;
+    if (m_rxSample.size() > SampleSize)
+        m_rxSample.remove(0, m_rxSample.size() - SampleSize);
+
+    m_rxText.clear();
+
+    if (!m_summaryTimer.isActive()) {
+        showStatusMessage(tr("Data arrives faster than it can be shown, see log"));
+        m_summaryTimer.start(SummaryInterval);
+    }
+}
+
+void MainWindow::showSkipSummary()
+{
+    if (m_skippedChars) {
+        const int lineStart = m_rxSample.indexOf(QLatin1Char('\n')) + 1;
+        console->putData(tr("\n[%1 lines / %2 KB received too fast, showing the last lines only,"
+                            " see log]\n").arg(m_skippedLines).arg(m_skippedChars / 1024)
+                         + m_rxSample.mid(lineStart));
+    }
+
+    m_skippedLines = 0;
+    m_skippedChars = 0;
+    m_rxSample.clear();
+
+    if (m_overload.tryRecover())
+        showStatusMessage(tr("Display resumed"));
+    else
+        m_summaryTimer.start(SummaryInterval);
 }
 
 //! [8]
 void MainWindow::handleError(QSerialPort::SerialPortError error)
 {
-    if (QSerialPort::ResourceError == error) {
+    if (QSerialPort::ResourceError != error || reconnector->isActive())
+        return;
+
+    if (autoReconnect) {
+        portLost();
+    } else {
+        if (transfer)
+            transfer->abandon();
         //    QMessageBox::critical(this, tr("Critical Error"), serial->errorString());
         closeSerialPort();
     }
 }
 //! [8]
 
+void MainWindow::portLost()
+{
+    if (transfer)
+        transfer->abandon();
+
+    bulk->cancel();
+    latency->stop();
+    reconnector->start(m_portLocation);
+
+    // A line cut by the loss must not be glued to the first one after it.
+    m_extractor.reset();
+
+    ui->actionLatency->setEnabled(false);
+    ui->actionSendFile->setEnabled(false);
+    ui->actionReceiveFile->setEnabled(false);
+
+    appendMarker(tr("%1 lost at %2").arg(serial->portName())
+                 .arg(QTime::currentTime().toString(QLatin1String("hh:mm:ss.zzz"))));
+    showStatusMessage(tr("%1 lost, waiting for it to come back...").arg(serial->portName()));
+}
+
+void MainWindow::portRestored(qint64 nsecs)
+{
+    // The port keeps the rest of the settings it was opened with.
+    const SettingsDialog::Settings p = settings->settings();
+    serial->setDataTerminalReady(p.dtrEnabled);
+    serial->setRequestToSend(p.rtsEnabled);
+
+    ui->actionLatency->setEnabled(true);
+    ui->actionSendFile->setEnabled(true);
+    ui->actionReceiveFile->setEnabled(true);
+
+    // A board that was reset shows its boot prompts again.
+    responder->rearm();
+
+    const QString elapsed = QString::number(nsecs / 1e6, 'f', 1);
+    appendMarker(tr("%1 reconnected after %2 ms").arg(serial->portName()).arg(elapsed));
+    showStatusMessage(tr("Reconnected to %1 after %2 ms").arg(serial->portName()).arg(elapsed));
+}
+
+void MainWindow::appendMarker(const QString &text)
+{
+    const QString marker = QLatin1String("\n[") + text + QLatin1String("]\n");
+    m_scrollback.append(marker);
+    m_rxText += m_sanitizer.process(marker);
+    flushBuffer();
+}
+
+void MainWindow::toggleTrace(bool enabled)
+{
+    if (enabled) {
+        Tracer::clear();
+        Tracer::setEnabled(true);
+        showStatusMessage(tr("Tracing the data path, uncheck to save the trace"));
+        return;
+    }
+
+    Tracer::setEnabled(false);
+
+    const QString fileName = QFileDialog::getSaveFileName(this, tr("Save trace"), QString(),
+                                                          tr("Chrome trace (*.json);;"
+                                                             "All Files (*)"));
+    if (fileName.isEmpty())
+        return;
+
+    QFile file(fileName);
+    if (!file.open(QFile::WriteOnly) || !Tracer::write(&file)) {
+        QMessageBox::warning(this, tr("Warning!"),
+                             tr("Could not write to file %1:\n%2")
+                             .arg(fileName)
+                             .arg(file.errorString()));
+        return;
+    }
+
+    showStatusMessage(tr("Trace saved, open it in chrome://tracing or ui.perfetto.dev"));
+}
+
+void MainWindow::updateBridgeStatus()
+{
+    if (bridge->isListening())
+        status->setText(tr("Shared at %1, clients: %2").arg(bridge->address())
+                        .arg(bridge->clientCount()));
+    else
+        status->clear();
+}
+
 void MainWindow::initActionsConnections()
 {
     connect(ui->actionOpen, &QAction::triggered, this, &MainWindow::fileOpen);
     connect(ui->actionSave, &QAction::triggered, this, &MainWindow::fileSave);
+    connect(ui->actionSendFile, &QAction::triggered, this, &MainWindow::sendFile);
+    connect(ui->actionReceiveFile, &QAction::triggered, this, &MainWindow::receiveFile);
     connect(ui->actionConnect, &QAction::triggered, this, &MainWindow::openSerialPort);
     connect(ui->actionDisconnect, &QAction::triggered, this, &MainWindow::closeSerialPort);
     connect(ui->actionQuit, &QAction::triggered, this, &MainWindow::close);
     connect(ui->actionConfigure, &QAction::triggered, settings, &SettingsDialog::show);
     connect(ui->actionClear, &QAction::triggered, console, &Console::clear);
+    connect(ui->actionClear, &QAction::triggered, plot, &PlotWidget::clear);
+    connect(ui->actionClear, &QAction::triggered, [this]() { m_scrollback.clear(); });
+    connect(ui->actionClear, &QAction::triggered, filterView, &FilterView::clear);
+    connect(ui->actionLatency, &QAction::triggered, latencyDialog, &LatencyDialog::show);
+    connect(ui->actionExpect, &QAction::triggered, expectDialog, &ExpectDialog::show);
+    connect(ui->actionTrace, &QAction::toggled, this, &MainWindow::toggleTrace);
+    connect(ui->actionPlot, &QAction::toggled, plotDock, &QDockWidget::setVisible);
+    connect(plotDock->toggleViewAction(), &QAction::toggled, ui->actionPlot, &QAction::setChecked);
+    connect(ui->actionFilter, &QAction::toggled, filterDock, &QDockWidget::setVisible);
+    connect(filterDock->toggleViewAction(), &QAction::toggled, ui->actionFilter, &QAction::setChecked);
     connect(ui->actionAbout, &QAction::triggered, this, &MainWindow::about);
     connect(ui->actionAboutQt, &QAction::triggered, qApp, &QApplication::aboutQt);
 }
@@ -217,25 +548,129 @@ void MainWindow::fileOpen()
     QString fileName = QFileDialog::getOpenFileName(this, tr("Open file"), QString(),
                                                     tr("Text files (*.txt);;"
                                                        "All Files (*)"));
-    if (!fileName.isEmpty()) {
-        QFile file(fileName);
-        if (!file.open(QFile::ReadOnly)) {
-            QMessageBox::warning(this, tr("Codecs"),
-                                 tr("Can't read file %1:\n%2")
-                                 .arg(fileName)
-                                 .arg(file.errorString()));
-            return;
+    if (!fileName.isEmpty())
+        sendFiles(QStringList(fileName));
+}
+
+void MainWindow::sendFileContents(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly)) {
+        QMessageBox::warning(this, tr("Codecs"),
+                             tr("Can't read file %1:\n%2")
+                             .arg(fileName)
+                             .arg(file.errorString()));
+        return;
+    }
+
+    QByteArray data = file.readAll();
+    file.close();
+
+    // The file is shown as it goes out, see echoSent().
+    if (!sendBulk(data, tr("Sending %1...").arg(QFileInfo(fileName).fileName()), true))
+        showStatusMessage(tr("%1 was not sent").arg(QFileInfo(fileName).fileName()));
+}
+
+void MainWindow::sendFiles(const QStringList &fileNames)
+{
+    if (!serial->isOpen())
+        openSerialPort();
+
+    // openSerialPort() has shown why, only say what became of the files.
+    if (!serial->isOpen()) {
+        showStatusMessage(tr("Not connected, %n file(s) not sent", nullptr, fileNames.size()));
+        return;
+    }
+
+    for (const QString &fileName : fileNames)
+        sendFileContents(fileName);
+}
+
+void MainWindow::sendText(const QString &text)
+{
+    // Line ends go out the way the Enter key sends them.
+    QString lines = text;
+    lines.replace(QLatin1String("\r\n"), QLatin1String("\r"));
+    lines.replace(QLatin1Char('\n'), QLatin1Char('\r'));
+
+    sendBulk(codec->fromUnicode(lines), tr("Sending pasted data..."));
+}
+
+bool MainWindow::sendBulk(const QByteArray &data, const QString &label, bool echo)
+{
+    // Nothing may get in the way of a running file transfer.
+    if (transfer || !serial->isOpen() || data.isEmpty())
+        return false;
+
+    if (!bulkProgress) {
+        bulkProgress = new QProgressDialog(label, tr("Cancel"), 0, 100, this);
+        // Short pastes are gone before it would show.
+        bulkProgress->setMinimumDuration(500);
+        bulkProgress->setValue(0);
+        connect(bulkProgress, &QProgressDialog::canceled, bulk, &BulkSender::cancel);
+    } else {
+        bulkProgress->setLabelText(label);
+    }
+
+    // Booked before send(), which may write and finish a short queue at once.
+    if (echo)
+        m_echoFiles.append({ m_bulkQueued, data });
+    m_bulkQueued += data.size();
+
+    bulk->send(data);
+    return true;
+}
+
+void MainWindow::echoSent(qint64 done)
+{
+    // What is written to the port goes through the same display path as the
+    // received text, so a large file cannot stall the window either.
+    while (!m_echoFiles.isEmpty() && m_bulkEchoed < done) {
+        const EchoFile &file = m_echoFiles.constFirst();
+        if (m_bulkEchoed < file.from) {
+            m_bulkEchoed = qMin(done, file.from);
+            continue;
         }
 
-        if (!serial->isOpen())
-            openSerialPort();
+        if (m_bulkEchoed == file.from) {
+            delete echoDecoder;
+            echoDecoder = codec->makeDecoder();
+            // The received text keeps its own column count.
+            m_echoSanitizer.setMaxLineLength(m_sanitizer.maxLineLength());
+            m_echoSanitizer.setControlChars(m_sanitizer.controlChars());
+            m_echoSanitizer.reset();
+        }
 
-        QByteArray data = file.readAll();
-        file.close();
-        writeData(data);
+        const qint64 end = qMin(done, file.from + file.data.size());
+        const QString text = echoDecoder->toUnicode(file.data.constData() + (m_bulkEchoed - file.from),
+                                                    int(end - m_bulkEchoed));
+        m_bulkEchoed = end;
+        if (end == file.from + file.data.size())
+            m_echoFiles.removeFirst();
 
-        console->putData(codec->toUnicode(data));
+        m_scrollback.append(text);
+        m_overload.received(text.size());
+        m_rxText += m_echoSanitizer.process(text);
     }
+
+    flushBuffer();
+}
+
+void MainWindow::bulkFinished(bool ok, const QString &message)
+{
+    Q_UNUSED(ok);
+
+    // Whatever was not sent is not shown either.
+    m_echoFiles.clear();
+    m_bulkQueued = 0;
+    m_bulkEchoed = 0;
+
+    if (bulkProgress) {
+        bulkProgress->deleteLater();
+        bulkProgress = nullptr;
+    }
+
+    showStatusMessage(message);
 }
 
 void MainWindow::writeToFile(const QString &fileName)
@@ -250,9 +685,7 @@ void MainWindow::writeToFile(const QString &fileName)
             return;
         }
 
-        QTextStream out(&file);
-        out.setCodec("UTF-8");
-        out << console->toPlainText();
+        m_scrollback.write(&file);
         file.close();
     }
 }
@@ -268,3 +701,96 @@ void MainWindow::fileSave()
     writeToFile(fileName);
 }
 
+FileTransfer *MainWindow::startTransfer(const QString &title)
+{
+    bool ok = false;
+    const QStringList protocols = FileTransfer::protocolNames();
+    const QString protocol = QInputDialog::getItem(this, title, tr("Protocol:"), protocols,
+                                                   protocols.size() - 1, false, &ok);
+    if (!ok)
+        return nullptr;
+
+    FileTransfer *t = FileTransfer::create(
+                static_cast<FileTransfer::Protocol>(protocols.indexOf(protocol)), serial, this);
+
+    transferProgress = new QProgressDialog(title + QLatin1Char(' ') + protocol, tr("Cancel"),
+                                           0, 100, this);
+    transferProgress->setMinimumDuration(0);
+    transferProgress->setValue(0);
+
+    connect(transferProgress, &QProgressDialog::canceled, t, &FileTransfer::cancel);
+    connect(t, &FileTransfer::finished, this, &MainWindow::transferFinished);
+    connect(t, &FileTransfer::progress, [this](qint64 done, qint64 total) {
+        if (transferProgress && total > 0)
+            transferProgress->setValue(int(qMin(done, total) * 100 / total));
+    });
+
+    return t;
+}
+
+void MainWindow::sendFile()
+{
+    if (transfer || bulk->isRunning() || !serial->isOpen())
+        return;
+
+    FileTransfer *t = startTransfer(tr("Send"));
+    if (!t)
+        return;
+
+    const QStringList fileNames = QFileDialog::getOpenFileNames(this, tr("Send files"));
+    if (fileNames.isEmpty()) {
+        transferProgress->deleteLater();
+        transferProgress = nullptr;
+        t->deleteLater();
+        return;
+    }
+
+    transfer = t;
+    showStatusMessage(tr("Sending..."));
+    transfer->send(fileNames);
+}
+
+void MainWindow::receiveFile()
+{
+    if (transfer || bulk->isRunning() || !serial->isOpen())
+        return;
+
+    FileTransfer *t = startTransfer(tr("Receive"));
+    if (!t)
+        return;
+
+    const QString path = t->isBatch()
+            ? QFileDialog::getExistingDirectory(this, tr("Receive files to"))
+            : QFileDialog::getSaveFileName(this, tr("Receive file as"));
+    if (path.isEmpty()) {
+        transferProgress->deleteLater();
+        transferProgress = nullptr;
+        t->deleteLater();
+        return;
+    }
+
+    transfer = t;
+    showStatusMessage(tr("Receiving..."));
+    transfer->receive(path);
+}
+
+void MainWindow::transferFinished(bool ok, const QString &message)
+{
+    const QString statistics = transfer->statistics();
+    const bool cancelled = transfer->isCancelled();
+    transfer->deleteLater();
+    transfer = nullptr;
+
+    transferProgress->deleteLater();
+    transferProgress = nullptr;
+
+    showStatusMessage(message + QLatin1String(": ") + statistics);
+    if (ok || cancelled)
+        return;
+
+    // Failures are reported from inside the read and error handlers, the box
+    // waits until they have returned.
+    QMetaObject::invokeMethod(this, [this, message, statistics]() {
+        QMessageBox::warning(this, tr("Warning!"), message + QLatin1Char('\n') + statistics);
+    }, Qt::QueuedConnection);
+}
@@ -40,11 +40,20 @@
 #include <QtSerialPort/QSerialPort>
 #include <QTimer>
 
+#include "overloadguard.h"
+#include "samplebuffer.h"
+#include "scrollback.h"
+#include "textsanitizer.h"
+#include "valueextractor.h"
+
 QT_BEGIN_NAMESPACE
 
+class QDockWidget;
 class QLabel;
+class QProgressDialog;
 class QTimer;
 class QTextCodec;
+class QTextDecoder;
 
 namespace Ui {
 class MainWindow;
@@ -52,7 +61,17 @@ class MainWindow;
 
 QT_END_NAMESPACE
 
+class BulkSender;
 class Console;
+class ExpectDialog;
+class ExpectResponder;
+class FileTransfer;
+class FilterView;
+class LatencyDialog;
+class LatencyProbe;
+class PlotWidget;
+class Reconnector;
+class SerialBridge;
 class SettingsDialog;
 
 class MainWindow : public QMainWindow
@@ -68,28 +87,87 @@ private slots:
     void closeSerialPort();
     void about();
     void writeData(const QByteArray &data);
+    void sendNow(const QByteArray &data);
     void readData();
 
     void fileOpen();
     void fileSave();
+    void sendFile();
+    void receiveFile();
+    void transferFinished(bool ok, const QString &message);
+    void sendText(const QString &text);
+    void sendFiles(const QStringList &fileNames);
+    void bulkFinished(bool ok, const QString &message);
 
     void handleError(QSerialPort::SerialPortError error);
+    void portRestored(qint64 nsecs);
+    void updateBridgeStatus();
+    void showSkipSummary();
+    void toggleTrace(bool enabled);
 
 private:
     void initActionsConnections();
     void showStatusMessage(const QString &message);
     void writeToFile(const QString &fileName);
+    FileTransfer *startTransfer(const QString &title);
+    void sendFileContents(const QString &fileName);
+    bool sendBulk(const QByteArray &data, const QString &label, bool echo = false);
+    void echoSent(qint64 done);
     void flushBuffer();
+    void skipBuffer();
+    void portLost();
+    void appendMarker(const QString &text);
 
     Ui::MainWindow *ui = nullptr;
     QLabel  *status  = nullptr;
     Console *console = nullptr;
     SettingsDialog *settings = nullptr;
     QSerialPort    *serial   = nullptr;
+    SerialBridge   *bridge   = nullptr;
+    LatencyProbe   *latency  = nullptr;
+    Reconnector    *reconnector = nullptr;
+    ExpectResponder *responder = nullptr;
+    ExpectDialog   *expectDialog = nullptr;
+    LatencyDialog  *latencyDialog = nullptr;
+    FileTransfer   *transfer = nullptr;
+    QProgressDialog *transferProgress = nullptr;
+    BulkSender     *bulk     = nullptr;
+    QProgressDialog *bulkProgress = nullptr;
     QTextCodec     *codec    = nullptr;
+    QTextDecoder   *decoder  = nullptr;
+    QTextDecoder   *echoDecoder = nullptr;
+    PlotWidget     *plot     = nullptr;
+    QDockWidget    *plotDock = nullptr;
+    FilterView     *filterView = nullptr;
+    QDockWidget    *filterDock = nullptr;
     QTimer m_readTimer;
+    QTimer m_summaryTimer;
+    QString m_rxText;
+    QString m_portLocation;
+    QString m_rxSample;
+    qint64 m_skippedLines = 0;
+    qint64 m_skippedChars = 0;
+
+    // Dropped files in the bulk queue, shown as they go out. The offsets
+    // start over with every run of the queue.
+    struct EchoFile {
+        qint64 from;
+        QByteArray data;
+    };
+    QVector<EchoFile> m_echoFiles;
+    qint64 m_bulkQueued = 0;
+    qint64 m_bulkEchoed = 0;
+
+    Scrollback     m_scrollback;
+    TextSanitizer  m_sanitizer;
+    TextSanitizer  m_echoSanitizer;
+    OverloadGuard  m_overload;
+
+    SampleStore    m_samples;
+    ValueExtractor m_extractor;
 
     bool saveFileOnExit;
+    bool autoReconnect = true;
 };
 
 #endif // MAINWINDOW_H
@@ -0,0 +1,100 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include "overloadguard.h"
+
+namespace {
+
+// Longest acceptable console update, beyond that the window stops responding.
+const qint64 RenderBudget = 100;
+
+// Text waiting for display that is not worth rendering at once.
+const int MaxPending = 256 * 1024;
+
+// Input rate, chars per second, at which the full display is resumed.
+const qint64 ResumeRate = 16 * 1024;
+
+// The rate is measured over Buckets * BucketTime milliseconds.
+const qint64 BucketTime = 250;
+
+} // namespace
+
+OverloadGuard::OverloadGuard()
+{
+    reset();
+}
+
+void OverloadGuard::received(int chars)
+{
+    advance();
+    m_buckets[m_current] += chars;
+}
+
+void OverloadGuard::rendered(qint64 msecs)
+{
+    if (msecs > RenderBudget)
+        m_overloaded = true;
+}
+
+bool OverloadGuard::canRender(int pending)
+{
+    if (pending > MaxPending)
+        m_overloaded = true;
+
+    return !m_overloaded;
+}
+
+bool OverloadGuard::tryRecover()
+{
+    advance();
+    if (m_overloaded && rate() < ResumeRate)
+        m_overloaded = false;
+
+    return !m_overloaded;
+}
+
+void OverloadGuard::reset()
+{
+    for (qint64 &bucket : m_buckets)
+        bucket = 0;
+
+    m_clock.start();
+    m_bucketTime = 0;
+    m_current = 0;
+    m_overloaded = false;
+}
+
+qint64 OverloadGuard::rate() const
+{
+    qint64 total = 0;
+    for (qint64 bucket : m_buckets)
+        total += bucket;
+
+    return total * 1000 / (Buckets * BucketTime);
+}
+
+void OverloadGuard::advance()
+{
+    const qint64 now = m_clock.elapsed();
+    for (int i = 0; i < Buckets && now - m_bucketTime >= BucketTime; ++i) {
+        m_current = (m_current + 1) % Buckets;
+        m_buckets[m_current] = 0;
+        m_bucketTime += BucketTime;
+    }
+
+    if (now - m_bucketTime >= BucketTime)
+        m_bucketTime = now;
+}
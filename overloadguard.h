@@ -0,0 +1,52 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef OVERLOADGUARD_H
+#define OVERLOADGUARD_H
+
+#include <QElapsedTimer>
+
+// Decides when the console cannot keep up with the incoming data. The display
+// is considered overloaded when a single update takes too long or too much
+// text piles up, and it recovers once the input rate has dropped for a while.
+class OverloadGuard
+{
+public:
+    OverloadGuard();
+
+    void received(int chars);
+    void rendered(qint64 msecs);
+
+    bool canRender(int pending);
+    bool isOverloaded() const { return m_overloaded; }
+    bool tryRecover();
+    void reset();
+
+    qint64 rate() const;
+
+private:
+    void advance();
+
+    static const int Buckets = 4;
+
+    QElapsedTimer m_clock;
+    qint64 m_buckets[Buckets];
+    qint64 m_bucketTime = 0;
+    int    m_current    = 0;
+    bool   m_overloaded = false;
+};
+
+#endif // OVERLOADGUARD_H
@@ -0,0 +1,188 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QPainter>
+#include <QWheelEvent>
+#include <limits>
+
+#include "plotwidget.h"
+
+namespace {
+
+const int Margin = 8;
+const int RefreshInterval = 40;
+const qint64 MinSpan = 16;
+
+const QColor seriesColors[] = {
+    Qt::green, Qt::yellow, Qt::cyan, Qt::magenta,
+    Qt::red, Qt::white, QColor(255, 128, 0), QColor(128, 128, 255)
+};
+
+} // namespace
+
+PlotWidget::PlotWidget(SampleStore *store, QWidget *parent) :
+    QWidget(parent),
+    m_store(store)
+{
+    QPalette p = palette();
+    p.setColor(QPalette::Window, Qt::black);
+    p.setColor(QPalette::WindowText, Qt::green);
+    setPalette(p);
+    setAutoFillBackground(true);
+    setMinimumHeight(120);
+
+    connect(&m_refreshTimer, &QTimer::timeout, this, &PlotWidget::refresh);
+}
+
+void PlotWidget::clear()
+{
+    m_store->clear();
+    m_span = 0;
+    update();
+}
+
+void PlotWidget::refresh()
+{
+    if (m_revision != m_store->revision()) {
+        m_revision = m_store->revision();
+        update();
+    }
+}
+
+void PlotWidget::showEvent(QShowEvent *e)
+{
+    m_refreshTimer.start(RefreshInterval);
+    QWidget::showEvent(e);
+}
+
+void PlotWidget::hideEvent(QHideEvent *e)
+{
+    m_refreshTimer.stop();
+    QWidget::hideEvent(e);
+}
+
+void PlotWidget::wheelEvent(QWheelEvent *e)
+{
+    qint64 available = 0;
+    for (const SampleSeries &s : m_store->allSeries())
+        available = qMax(available, s.count());
+
+    if (0 == m_span || m_span > available)
+        m_span = available;
+
+    if (e->angleDelta().y() > 0)
+        m_span = qMax(MinSpan, m_span / 2);
+    else
+        m_span *= 2;
+
+    if (m_span >= available)
+        m_span = 0;
+
+    update();
+    e->accept();
+}
+
+void PlotWidget::paintEvent(QPaintEvent *)
+{
+    const QVector<SampleSeries> &series = m_store->allSeries();
+    const QRect area = rect().adjusted(Margin, Margin, -Margin, -Margin);
+    if (series.isEmpty() || area.width() < 2 || area.height() < 2)
+        return;
+
+    // Reduce every series to at most one min/max pair per pixel column, the
+    // cost does not depend on the number of stored samples.
+    m_columns.resize(series.size());
+    double low  = std::numeric_limits<double>::max();
+    double high = std::numeric_limits<double>::lowest();
+
+    for (int i = 0; i < series.size(); ++i) {
+        const SampleSeries &s = series.at(i);
+        const qint64 count = m_span ? qMin(m_span, s.count()) : s.count();
+        if (!count) {
+            m_columns[i].clear();
+            continue;
+        }
+
+        s.decimate(s.first() + s.count() - count, count,
+                   int(qMin<qint64>(count, area.width())), m_columns[i]);
+
+        for (const SampleSeries::Range &r : m_columns.at(i)) {
+            low  = qMin(low, r.min);
+            high = qMax(high, r.max);
+        }
+    }
+
+    if (low > high)
+        return;
+
+    if (qFuzzyCompare(low, high)) {
+        low  -= 1.0;
+        high += 1.0;
+    }
+
+    const double scale = (area.height() - 1) / (high - low);
+    auto toY = [&](double v) { return area.bottom() - (v - low) * scale; };
+
+    QPainter painter(this);
+    painter.setPen(QColor(48, 48, 48));
+    painter.drawRect(area);
+
+    const int colorCount = int(sizeof(seriesColors) / sizeof(seriesColors[0]));
+    QVector<QLineF> lines;
+
+    for (int i = 0; i < series.size(); ++i) {
+        const QVector<SampleSeries::Range> &columns = m_columns.at(i);
+        const int n = columns.size();
+        if (!n)
+            continue;
+
+        lines.clear();
+        const double step = n > 1 ? double(area.width() - 1) / (n - 1) : 0.0;
+
+        for (int c = 0; c < n; ++c) {
+            const double x = area.left() + c * step;
+            SampleSeries::Range r = columns.at(c);
+
+            if (c) {
+                // Join with the previous column so the trace has no gaps.
+                const SampleSeries::Range &prev = columns.at(c - 1);
+                if (n < area.width()) {
+                    lines.append(QLineF(x - step, toY(prev.max), x, toY(r.max)));
+                    continue;
+                }
+                r.min = qMin(r.min, prev.max);
+                r.max = qMax(r.max, prev.min);
+            }
+
+            lines.append(QLineF(x, toY(r.min), x, toY(r.max)));
+        }
+
+        painter.setPen(seriesColors[i % colorCount]);
+        painter.drawLines(lines);
+    }
+
+    const int lineHeight = fontMetrics().height();
+    for (int i = 0; i < series.size(); ++i) {
+        painter.setPen(seriesColors[i % colorCount]);
+        painter.drawText(area.left() + Margin, area.top() + lineHeight * (i + 1),
+                         QStringLiteral("%1 = %2").arg(series.at(i).name())
+                         .arg(series.at(i).last()));
+    }
+
+    painter.setPen(palette().color(QPalette::WindowText));
+    painter.drawText(area, Qt::AlignRight | Qt::AlignTop, QString::number(high));
+    painter.drawText(area, Qt::AlignRight | Qt::AlignBottom, QString::number(low));
+}
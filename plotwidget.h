@@ -0,0 +1,51 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef PLOTWIDGET_H
+#define PLOTWIDGET_H
+
+#include <QWidget>
+#include <QTimer>
+
+#include "samplebuffer.h"
+
+class PlotWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit PlotWidget(SampleStore *store, QWidget *parent = nullptr);
+
+public slots:
+    void clear();
+
+protected:
+    void paintEvent(QPaintEvent *e) Q_DECL_OVERRIDE;
+    void wheelEvent(QWheelEvent *e) Q_DECL_OVERRIDE;
+    void showEvent(QShowEvent *e) Q_DECL_OVERRIDE;
+    void hideEvent(QHideEvent *e) Q_DECL_OVERRIDE;
+
+private:
+    void refresh();
+
+    SampleStore *m_store = nullptr;
+    QTimer m_refreshTimer;
+    QVector<QVector<SampleSeries::Range>> m_columns;
+    quint64 m_revision = 0;
+    qint64  m_span = 0;
+};
+
+#endif // PLOTWIDGET_H
@@ -0,0 +1,85 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QFileInfo>
+#include <QtSerialPort/QSerialPort>
+
+#include "reconnector.h"
+
+namespace {
+
+const int RetryInterval = 10;
+
+} // namespace
+
+Reconnector::Reconnector(QSerialPort *port, QObject *parent) :
+    QObject(parent),
+    m_port(port)
+{
+    connect(&m_retryTimer, &QTimer::timeout, this, &Reconnector::tryOpen);
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &Reconnector::tryOpen);
+}
+
+void Reconnector::start(const QString &location)
+{
+    m_lost.start();
+    m_location = location;
+
+#ifdef Q_OS_UNIX
+    if (m_location.isEmpty()) {
+        m_location = m_port->portName();
+        if (!QFileInfo(m_location).isAbsolute())
+            m_location.prepend(QLatin1String("/dev/"));
+    }
+#endif
+
+    if (m_port->isOpen())
+        m_port->close();
+
+#ifdef Q_OS_UNIX
+    m_watcher.addPath(QFileInfo(m_location).absolutePath());
+#endif
+
+    m_retryTimer.start(RetryInterval);
+}
+
+void Reconnector::stop()
+{
+    m_retryTimer.stop();
+
+    const QStringList paths = m_watcher.directories();
+    if (!paths.isEmpty())
+        m_watcher.removePaths(paths);
+}
+
+void Reconnector::tryOpen()
+{
+    if (!isActive())
+        return;
+
+#ifdef Q_OS_UNIX
+    if (!QFileInfo::exists(m_location))
+        return;
+#endif
+
+    // The node may show up before its permissions are set, the timer retries.
+    if (!m_port->open(QIODevice::ReadWrite))
+        return;
+
+    const qint64 nsecs = m_lost.nsecsElapsed();
+    stop();
+    emit reconnected(nsecs);
+}
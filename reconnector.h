@@ -0,0 +1,58 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef RECONNECTOR_H
+#define RECONNECTOR_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QFileSystemWatcher>
+#include <QTimer>
+
+QT_BEGIN_NAMESPACE
+class QSerialPort;
+QT_END_NAMESPACE
+
+// Reopens a port whose device went away. The directory of the device node is
+// watched so the port is tried the moment the node is back, and a short
+// retry timer covers the time until the node becomes accessible.
+class Reconnector : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit Reconnector(QSerialPort *port, QObject *parent = nullptr);
+
+    // The location must be taken while the device is still there, the
+    // port info of a device that is gone is empty.
+    void start(const QString &location);
+    void stop();
+    bool isActive() const { return m_retryTimer.isActive(); }
+
+signals:
+    void reconnected(qint64 nsecs);
+
+private:
+    void tryOpen();
+
+    QSerialPort *m_port = nullptr;
+    QFileSystemWatcher m_watcher;
+    QTimer m_retryTimer;
+    QElapsedTimer m_lost;
+    QString m_location;
+};
+
+#endif // RECONNECTOR_H
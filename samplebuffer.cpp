@@ -0,0 +1,177 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <limits>
+
+#include <QDebug>
+
+#include "samplebuffer.h"
+
+namespace {
+
+const int FineShift   = 6;
+const int CoarseShift = 12;
+const qint64 FineBlock   = qint64(1) << FineShift;
+const qint64 CoarseBlock = qint64(1) << CoarseShift;
+
+inline void merge(SampleSeries::Range &r, double v)
+{
+    if (v < r.min)
+        r.min = v;
+    if (v > r.max)
+        r.max = v;
+}
+
+inline void merge(SampleSeries::Range &r, const SampleSeries::Range &o)
+{
+    if (o.min < r.min)
+        r.min = o.min;
+    if (o.max > r.max)
+        r.max = o.max;
+}
+
+} // namespace
+
+SampleSeries::SampleSeries(const QString &name, int capacity) :
+    m_name(name)
+{
+    m_capacity = int(CoarseBlock);
+    while (m_capacity < capacity)
+        m_capacity <<= 1;
+
+    m_values.resize(int(CoarseBlock));
+    m_fine.resize(int(CoarseBlock >> FineShift));
+    m_coarse.resize(1);
+    m_mask = CoarseBlock - 1;
+}
+
+// Only done before the first wrap, so every sample keeps its slot.
+void SampleSeries::grow()
+{
+    const int size = m_values.size() * 2;
+    m_values.resize(size);
+    m_fine.resize(size >> FineShift);
+    m_coarse.resize(size >> CoarseShift);
+    m_mask = size - 1;
+}
+
+void SampleSeries::append(double value)
+{
+    if (m_total == m_mask + 1 && m_values.size() < m_capacity)
+        grow();
+
+    const int slot = int(m_total & m_mask);
+    m_values[slot] = value;
+
+    Range &fine = m_fine[slot >> FineShift];
+    if (0 == (slot & (FineBlock - 1)))
+        fine = Range{value, value};
+    else
+        merge(fine, value);
+
+    Range &coarse = m_coarse[slot >> CoarseShift];
+    if (0 == (slot & (CoarseBlock - 1)))
+        coarse = Range{value, value};
+    else
+        merge(coarse, value);
+
+    ++m_total;
+}
+
+void SampleSeries::clear()
+{
+    m_total = 0;
+}
+
+qint64 SampleSeries::first() const
+{
+    return m_total - count();
+}
+
+qint64 SampleSeries::count() const
+{
+    if (m_total <= m_mask + 1)
+        return m_total;
+
+    // The coarse block currently being overwritten no longer describes the
+    // oldest samples, so it is excluded from the window.
+    return m_mask + 1 - CoarseBlock;
+}
+
+double SampleSeries::last() const
+{
+    return m_total ? value(m_total - 1) : 0.0;
+}
+
+void SampleSeries::decimate(qint64 first, qint64 count, int columns, QVector<Range> &out) const
+{
+    out.resize(columns);
+    if (columns <= 0)
+        return;
+
+    for (int c = 0; c < columns; ++c) {
+        const qint64 from = first + count * c / columns;
+        const qint64 to   = first + count * (c + 1) / columns;
+        out[c] = range(from, qMax(to, from + 1));
+    }
+}
+
+SampleSeries::Range SampleSeries::range(qint64 from, qint64 to) const
+{
+    Range r{std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest()};
+
+    while (from < to) {
+        const int slot = int(from & m_mask);
+        if (0 == (from & (CoarseBlock - 1)) && from + CoarseBlock <= to) {
+            merge(r, m_coarse.at(slot >> CoarseShift));
+            from += CoarseBlock;
+        } else if (0 == (from & (FineBlock - 1)) && from + FineBlock <= to) {
+            merge(r, m_fine.at(slot >> FineShift));
+            from += FineBlock;
+        } else {
+            merge(r, m_values.at(slot));
+            ++from;
+        }
+    }
+
+    return r;
+}
+
+SampleSeries *SampleStore::series(const QString &name)
+{
+    auto it = m_index.constFind(name);
+    if (it != m_index.constEnd())
+        return &m_series[it.value()];
+
+    if (m_series.size() >= MaxSeries) {
+        if (!m_full)
+            qWarning() << "Plot series limit reached, ignoring" << name << "and later names";
+        m_full = true;
+        return nullptr;
+    }
+
+    m_index.insert(name, m_series.size());
+    m_series.append(SampleSeries(name));
+    return &m_series.last();
+}
+
+void SampleStore::clear()
+{
+    m_series.clear();
+    m_index.clear();
+    m_full = false;
+    ++m_revision;
+}
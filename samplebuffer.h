@@ -0,0 +1,88 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef SAMPLEBUFFER_H
+#define SAMPLEBUFFER_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+// Bounded ring of samples for a single extracted value. It starts small and
+// doubles up to the capacity before it wraps. Besides the raw column two
+// levels of min/max summaries are kept up to date on append, so a range of
+// any length can be reduced to its extremes in a bounded number of steps.
+class SampleSeries
+{
+public:
+    struct Range {
+        double min;
+        double max;
+    };
+
+    explicit SampleSeries(const QString &name = QString(), int capacity = DefaultCapacity);
+
+    void append(double value);
+    void clear();
+
+    QString name() const { return m_name; }
+    qint64 first() const;
+    qint64 count() const;
+    double last() const;
+
+    // Splits [first, first + count) into columns and stores min/max of each.
+    void decimate(qint64 first, qint64 count, int columns, QVector<Range> &out) const;
+    double value(qint64 index) const { return m_values.at(int(index & m_mask)); }
+
+    static const int DefaultCapacity = 1 << 20;
+
+private:
+    Range range(qint64 from, qint64 to) const;
+    void grow();
+
+    QString m_name;
+    QVector<double> m_values;
+    QVector<Range>  m_fine;
+    QVector<Range>  m_coarse;
+    qint64 m_total = 0;
+    qint64 m_mask  = 0;
+    int m_capacity = 0;
+};
+
+// Columnar storage of all series, one ring per value name. Names beyond the
+// limit are dropped, so a pattern matching every "key: number" of a log
+// cannot take all the memory.
+class SampleStore
+{
+public:
+    // Null once MaxSeries names are in use.
+    SampleSeries *series(const QString &name);
+    const QVector<SampleSeries> &allSeries() const { return m_series; }
+
+    void clear();
+    quint64 revision() const { return m_revision; }
+    void touch() { ++m_revision; }
+
+    static const int MaxSeries = 32;
+
+private:
+    QVector<SampleSeries> m_series;
+    QHash<QString, int>   m_index;
+    quint64 m_revision = 0;
+    bool m_full = false;
+};
+
+#endif // SAMPLEBUFFER_H
@@ -0,0 +1,160 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QIODevice>
+#include <QTextStream>
+#include <algorithm>
+#include <limits>
+
+#include "scrollback.h"
+#include "tracer.h"
+
+namespace {
+
+// Size of a block, a new one is started when it is reached.
+const int BlockSize = 1024 * 1024;
+
+} // namespace
+
+void Scrollback::append(const QString &text)
+{
+    TRACE_SCOPE("Scrollback::append");
+
+    if (text.isEmpty())
+        return;
+
+    if (m_blocks.isEmpty()) {
+        m_blocks.append(Block());
+        m_blocks.last().text.reserve(BlockSize);
+    }
+
+    m_size += text.size();
+
+    int from = 0;
+    int end = text.indexOf(QLatin1Char('\n'));
+    while (from < text.size()) {
+        Block &block = m_blocks.last();
+        const int room = BlockSize - block.text.size();
+
+        if (end >= 0 && end < from)
+            end = text.indexOf(QLatin1Char('\n'), from);
+
+        if (end >= 0 && end - from < room) {
+            block.text.append(text.midRef(from, end - from + 1));
+            block.lineEnds.append(block.text.size() - 1);
+            ++m_lines;
+            from = end + 1;
+        } else {
+            const int n = qMin(room, text.size() - from);
+            block.text.append(text.midRef(from, n));
+            from += n;
+        }
+
+        if (block.text.size() >= BlockSize) {
+            Block next;
+            next.firstLine = m_lines;
+            next.text.reserve(BlockSize);
+            m_blocks.append(next);
+        }
+    }
+
+    const int last = text.lastIndexOf(QLatin1Char('\n'));
+    if (last >= 0)
+        m_lastLineEnd = m_size - text.size() + last + 1;
+}
+
+void Scrollback::chop(int n)
+{
+    if (m_blocks.isEmpty())
+        return;
+
+    // Only the part of the unfinished last line in the last block can be
+    // taken back.
+    Block &block = m_blocks.last();
+    const int tail = block.lineEnds.isEmpty() ? 0 : block.lineEnds.last() + 1;
+    n = qMin(n, block.text.size() - tail);
+    if (n <= 0)
+        return;
+
+    block.text.chop(n);
+    m_size -= n;
+}
+
+void Scrollback::clear()
+{
+    m_blocks.clear();
+    m_lines = 0;
+    m_size  = 0;
+    m_lastLineEnd = 0;
+}
+
+qint64 Scrollback::lineCount() const
+{
+    // The last line may still be waiting for its end.
+    return m_lines + (m_size > m_lastLineEnd ? 1 : 0);
+}
+
+QString Scrollback::line(qint64 index, int maxLength) const
+{
+    if (index < 0 || index >= lineCount())
+        return QString();
+
+    // The line begins after the end of the previous one.
+    int idx = 0;
+    int start = 0;
+    if (index > 0) {
+        idx = blockOfLineEnd(index - 1);
+        const Block &block = m_blocks.at(idx);
+        start = block.lineEnds.at(int(index - 1 - block.firstLine)) + 1;
+    }
+
+    if (maxLength < 0)
+        maxLength = std::numeric_limits<int>::max();
+
+    QString text;
+    for (; idx < m_blocks.size() && text.size() < maxLength; ++idx, start = 0) {
+        const Block &block = m_blocks.at(idx);
+        const qint64 local = index - block.firstLine;
+        const bool ends = local < block.lineEnds.size();
+        const int end = ends ? block.lineEnds.at(int(local)) : block.text.size();
+
+        text += block.text.midRef(start, qMin(end - start, maxLength - text.size()));
+        if (ends)
+            break;
+    }
+
+    return text;
+}
+
+bool Scrollback::write(QIODevice *device) const
+{
+    QTextStream out(device);
+    out.setCodec("UTF-8");
+
+    for (const Block &block : m_blocks)
+        out << block.text;
+
+    out.flush();
+    return QTextStream::Ok == out.status();
+}
+
+// The line end is in the last block that begins before it.
+int Scrollback::blockOfLineEnd(qint64 end) const
+{
+    auto it = std::upper_bound(m_blocks.cbegin(), m_blocks.cend(), end,
+                               [](qint64 l, const Block &b) { return l < b.firstLine; });
+    return int(it - m_blocks.cbegin()) - 1;
+}
@@ -0,0 +1,67 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef SCROLLBACK_H
+#define SCROLLBACK_H
+
+#include <QString>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QIODevice;
+QT_END_NAMESPACE
+
+// Append-only store of everything received during the session. The text is
+// kept in blocks of bounded size, each with the offsets of its line ends, so
+// a line is addressed by its number alone. A block is full at BlockSize even
+// in the middle of a line, a line that long continues in the next block.
+class Scrollback
+{
+public:
+    // firstLine is the line the text of the block begins in.
+    struct Block {
+        QString text;
+        QVector<int> lineEnds;
+        qint64 firstLine = 0;
+    };
+
+    void append(const QString &text);
+    void chop(int n);
+    void clear();
+
+    bool isEmpty() const { return 0 == m_size; }
+    qint64 size() const { return m_size; }
+    qint64 lineCount() const;
+    qint64 completeLineCount() const { return m_lines; }
+    // At most maxLength characters of the line when maxLength is not -1.
+    QString line(qint64 index, int maxLength = -1) const;
+
+    bool write(QIODevice *device) const;
+
+    // Copying the blocks is cheap and gives a snapshot that other threads
+    // may read while new text is appended.
+    const QVector<Block> &blocks() const { return m_blocks; }
+
+private:
+    int blockOfLineEnd(qint64 end) const;
+
+    QVector<Block> m_blocks;
+    qint64 m_lines = 0;
+    qint64 m_size  = 0;
+    qint64 m_lastLineEnd = 0;   // size up to the end of the last complete line
+};
+
+#endif // SCROLLBACK_H
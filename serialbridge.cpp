@@ -0,0 +1,271 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QStringList>
+
+#include "serialbridge.h"
+
+namespace {
+
+// Data kept in the socket itself, the rest waits in the shared queue.
+const qint64 SocketHighWater = 64 * 1024;
+
+// A client that lags behind by more than that is disconnected.
+const qint64 MaxPendingBytes = 8 * 1024 * 1024;
+
+} // namespace
+
+SerialBridge::SerialBridge(QObject *parent) :
+    QObject(parent),
+    m_tcpServer(new QTcpServer(this)),
+    m_localServer(new QLocalServer(this))
+{
+    connect(m_tcpServer, &QTcpServer::newConnection, this, &SerialBridge::acceptTcpClients);
+    connect(m_localServer, &QLocalServer::newConnection, this, &SerialBridge::acceptLocalClients);
+}
+
+SerialBridge::~SerialBridge()
+{
+    // The owner may already be half destroyed, keep it out of the loop.
+    blockSignals(true);
+    close();
+}
+
+bool SerialBridge::listen(quint16 tcpPort, bool remote, const QString &socketName)
+{
+    close();
+
+    if (tcpPort && !m_tcpServer->listen(remote ? QHostAddress::Any : QHostAddress::LocalHost, tcpPort)) {
+        m_errorString = m_tcpServer->errorString();
+        return false;
+    }
+
+    if (!socketName.isEmpty() && !m_localServer->listen(socketName)) {
+        if (QAbstractSocket::AddressInUseError != m_localServer->serverError()) {
+            m_errorString = m_localServer->errorString();
+            m_tcpServer->close();
+            return false;
+        }
+
+        // The name may belong to another instance. Only a socket nobody
+        // answers on was left behind by a crash and may be removed, that is
+        // found out without blocking the window.
+        probeLocal(socketName);
+    }
+
+    m_errorString.clear();
+    return true;
+}
+
+void SerialBridge::probeLocal(const QString &socketName)
+{
+    QLocalSocket *probe = new QLocalSocket(this);
+    m_probe = probe;
+
+    connect(probe, &QLocalSocket::connected, this, [this, probe, socketName]() {
+        probed(probe, false, socketName);
+    });
+    connect(probe, static_cast<void (QLocalSocket::*)(QLocalSocket::LocalSocketError)>(&QLocalSocket::error),
+            this, [this, probe, socketName]() {
+        probed(probe, true, socketName);
+    });
+
+    probe->connectToServer(socketName);
+}
+
+void SerialBridge::probed(QLocalSocket *probe, bool stale, const QString &socketName)
+{
+    probe->disconnect(this);
+    probe->abort();
+    probe->deleteLater();
+
+    // close() or another listen() came in between.
+    if (probe != m_probe)
+        return;
+    m_probe = nullptr;
+
+    if (stale) {
+        QLocalServer::removeServer(socketName);
+        if (m_localServer->listen(socketName)) {
+            emit clientsChanged(m_clients.size());
+            return;
+        }
+        m_errorString = m_localServer->errorString();
+    } else {
+        m_errorString = tr("The local socket %1 is used by another application").arg(socketName);
+    }
+
+    emit listenFailed(m_errorString);
+}
+
+void SerialBridge::close()
+{
+    m_tcpServer->close();
+    m_localServer->close();
+
+    if (m_probe) {
+        m_probe->disconnect(this);
+        m_probe->abort();
+        m_probe->deleteLater();
+        m_probe = nullptr;
+    }
+
+    while (!m_clients.isEmpty())
+        drop(m_clients.last().socket);
+}
+
+bool SerialBridge::isListening() const
+{
+    return m_tcpServer->isListening() || m_localServer->isListening();
+}
+
+int SerialBridge::clientCount() const
+{
+    return m_clients.size();
+}
+
+QString SerialBridge::address() const
+{
+    QStringList list;
+    if (m_tcpServer->isListening())
+        list << QStringLiteral("%1:%2").arg(m_tcpServer->serverAddress().toString())
+                .arg(m_tcpServer->serverPort());
+    if (m_localServer->isListening())
+        list << m_localServer->fullServerName();
+
+    return list.join(QLatin1String(", "));
+}
+
+QString SerialBridge::errorString() const
+{
+    return m_errorString;
+}
+
+void SerialBridge::broadcast(const QByteArray &data)
+{
+    if (data.isEmpty())
+        return;
+
+    QVector<QIODevice *> lagging;
+
+    for (Client &client : m_clients) {
+        if (client.pendingBytes + data.size() > MaxPendingBytes) {
+            lagging << client.socket;
+            continue;
+        }
+
+        client.pending.enqueue(data);
+        client.pendingBytes += data.size();
+        flush(client);
+    }
+
+    for (QIODevice *socket : lagging)
+        drop(socket);
+}
+
+void SerialBridge::acceptTcpClients()
+{
+    while (QTcpSocket *socket = m_tcpServer->nextPendingConnection()) {
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        connect(socket, &QAbstractSocket::disconnected, this, &SerialBridge::removeClient);
+        addClient(socket);
+    }
+}
+
+void SerialBridge::acceptLocalClients()
+{
+    while (QLocalSocket *socket = m_localServer->nextPendingConnection()) {
+        connect(socket, &QLocalSocket::disconnected, this, &SerialBridge::removeClient);
+        addClient(socket);
+    }
+}
+
+void SerialBridge::readClient()
+{
+    QIODevice *socket = qobject_cast<QIODevice *>(sender());
+    if (socket)
+        emit dataReceived(socket->readAll());
+}
+
+void SerialBridge::writeClient()
+{
+    const int idx = indexOf(sender());
+    if (-1 != idx)
+        flush(m_clients[idx]);
+}
+
+void SerialBridge::removeClient()
+{
+    const int idx = indexOf(sender());
+    if (-1 == idx)
+        return;
+
+    m_clients.at(idx).socket->deleteLater();
+    m_clients.remove(idx);
+    emit clientsChanged(m_clients.size());
+}
+
+void SerialBridge::addClient(QIODevice *socket)
+{
+    connect(socket, &QIODevice::readyRead, this, &SerialBridge::readClient);
+    connect(socket, &QIODevice::bytesWritten, this, &SerialBridge::writeClient);
+
+    Client client;
+    client.socket = socket;
+    m_clients.append(client);
+    emit clientsChanged(m_clients.size());
+}
+
+void SerialBridge::flush(Client &client)
+{
+    while (!client.pending.isEmpty() && client.socket->bytesToWrite() < SocketHighWater) {
+        const QByteArray chunk = client.pending.dequeue();
+        client.pendingBytes -= chunk.size();
+        client.socket->write(chunk);
+    }
+}
+
+void SerialBridge::drop(QIODevice *socket)
+{
+    const int idx = indexOf(socket);
+    if (-1 == idx)
+        return;
+
+    m_clients.remove(idx);
+    socket->disconnect(this);
+
+    if (QAbstractSocket *tcp = qobject_cast<QAbstractSocket *>(socket))
+        tcp->abort();
+    else if (QLocalSocket *local = qobject_cast<QLocalSocket *>(socket))
+        local->abort();
+
+    socket->deleteLater();
+    emit clientsChanged(m_clients.size());
+}
+
+int SerialBridge::indexOf(QObject *socket) const
+{
+    for (int i = 0; i < m_clients.size(); ++i) {
+        if (m_clients.at(i).socket == socket)
+            return i;
+    }
+
+    return -1;
+}
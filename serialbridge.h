@@ -0,0 +1,90 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef SERIALBRIDGE_H
+#define SERIALBRIDGE_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QQueue>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QIODevice;
+class QTcpServer;
+class QLocalServer;
+class QLocalSocket;
+QT_END_NAMESPACE
+
+// Shares the serial port with TCP and local socket clients. Everything read
+// from the port is mirrored to every client and whatever a client sends is
+// handed back for transmission. The received chunks are implicitly shared
+// between the client queues, so the fan-out does not copy the data; a client
+// that falls too far behind is dropped.
+class SerialBridge : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SerialBridge(QObject *parent = nullptr);
+    ~SerialBridge() Q_DECL_OVERRIDE;
+
+    bool listen(quint16 tcpPort, bool remote, const QString &socketName);
+    void close();
+
+    bool isListening() const;
+    int clientCount() const;
+    QString address() const;
+    QString errorString() const;
+
+public slots:
+    void broadcast(const QByteArray &data);
+
+signals:
+    void dataReceived(const QByteArray &data);
+    void clientsChanged(int count);
+    // The local socket name turned out to be taken after listen() returned.
+    void listenFailed(const QString &errorString);
+
+private slots:
+    void acceptTcpClients();
+    void acceptLocalClients();
+    void readClient();
+    void writeClient();
+    void removeClient();
+
+private:
+    struct Client {
+        QIODevice *socket = nullptr;
+        QQueue<QByteArray> pending;
+        qint64 pendingBytes = 0;
+    };
+
+    void probeLocal(const QString &socketName);
+    void probed(QLocalSocket *probe, bool stale, const QString &socketName);
+    void addClient(QIODevice *socket);
+    void flush(Client &client);
+    void drop(QIODevice *socket);
+    int indexOf(QObject *socket) const;
+
+    QTcpServer   *m_tcpServer   = nullptr;
+    QLocalServer *m_localServer = nullptr;
+    QLocalSocket *m_probe = nullptr;
+    QVector<Client> m_clients;
+    QString m_errorString;
+};
+
+#endif // SERIALBRIDGE_H
@@ -38,21 +38,26 @@
 #include <QDir>
 #include <QCoreApplication>
 #include <QFileInfo>
+#include <QMessageBox>
 
+#include "autodetector.h"
 #include "settingsdialog.h"
 #include "ui_settingsdialog.h"
+#include "valueextractor.h"
 
 QT_USE_NAMESPACE
 
 static const char blankString[] = QT_TRANSLATE_NOOP("SettingsDialog", "N/A");
 
 SettingsDialog::SettingsDialog(QWidget *parent) :
+    SettingsDialog(fileName(), parent)
+{
+}
+
+SettingsDialog::SettingsDialog(const QString &fileName, QWidget *parent) :
     QDialog(parent),
     ui(new Ui::SettingsDialog)
 {
-    m_settings = new QSettings(QCoreApplication::applicationDirPath() + QDir::separator() +
-                               QFileInfo(QCoreApplication::applicationFilePath()).fileName() +
-                               QLatin1String(".ini"), QSettings::IniFormat);
     ui->setupUi(this);
     ui->baudRateBox->setInsertPolicy(QComboBox::NoInsert);
 
@@ -68,10 +73,17 @@ SettingsDialog::SettingsDialog(QWidget *parent) :
 
     intValidator = new QIntValidator(0, 4000000, this);
 
+    m_detector = new AutoDetector(this);
+    connect(ui->detectButton, &QPushButton::clicked, this, &SettingsDialog::detect);
+    connect(m_detector, &AutoDetector::finished, this, &SettingsDialog::detected);
+    connect(m_detector, &AutoDetector::progress, [this](qint32 baudRate) {
+        ui->detectButton->setText(tr("Detecting %1...").arg(baudRate));
+    });
+
     fillPortsParameters();
     fillPortsInfo();
 
-    updateSettings();
+    load(fileName);
 }
 
 SettingsDialog::~SettingsDialog()
@@ -84,6 +96,13 @@ SettingsDialog::Settings SettingsDialog::settings() const
     return currentSettings;
 }
 
+QString SettingsDialog::fileName()
+{
+    return QCoreApplication::applicationDirPath() + QDir::separator() +
+            QFileInfo(QCoreApplication::applicationFilePath()).fileName() +
+            QLatin1String(".ini");
+}
+
 void SettingsDialog::showPortInfo(int idx)
 {
     if (-1 == idx)
@@ -122,9 +141,20 @@ void SettingsDialog::apply()
     m_settings->setValue(QLatin1String("StopBits"), ui->stopBitsBox->currentText());
     m_settings->setValue(QLatin1String("FlowControl"), ui->flowControlBox->currentText());
     m_settings->setValue(QLatin1String("Encoding"), ui->encodingBox->currentText());
+    m_settings->setValue(QLatin1String("MaxLineLength"), ui->lineLengthBox->value());
+    m_settings->setValue(QLatin1String("ControlCharacters"), ui->controlCharsBox->currentText());
+    m_settings->setValue(QLatin1String("PastePacing"), ui->pastePacingBox->currentIndex());
+    m_settings->setValue(QLatin1String("PasteDelay"), ui->pasteDelayBox->value());
+    m_settings->setValue(QLatin1String("PastePrompt"), ui->pastePromptEdit->text());
     m_settings->setValue(QLatin1String("DTR"), ui->dtrCheckBox->isChecked());
     m_settings->setValue(QLatin1String("RTS"), ui->rtsCheckBox->isChecked());
+    m_settings->setValue(QLatin1String("Reconnect"), ui->reconnectCheckBox->isChecked());
     m_settings->setValue(QLatin1String("SaveDataOnExit"), ui->saveFileCheckBox->isChecked());
+    m_settings->setValue(QLatin1String("PlotPatterns"), currentSettings.plotPatterns);
+    m_settings->setValue(QLatin1String("Bridge"), ui->bridgeGroupBox->isChecked());
+    m_settings->setValue(QLatin1String("BridgeRemote"), ui->bridgeRemoteCheckBox->isChecked());
+    m_settings->setValue(QLatin1String("BridgePort"), ui->bridgePortBox->value());
+    m_settings->setValue(QLatin1String("BridgeSocket"), ui->bridgeSocketEdit->text());
 
     hide();
 }
@@ -148,6 +178,56 @@ void SettingsDialog::checkCustomDevicePathPolicy(int idx)
         ui->serialPortInfoListBox->clearEditText();
 }
 
+void SettingsDialog::detect()
+{
+    const bool started = m_detector->start(
+                ui->serialPortInfoListBox->currentText(),
+                static_cast<QSerialPort::DataBits>(ui->dataBitsBox->currentData().toInt()),
+                static_cast<QSerialPort::Parity>(ui->parityBox->currentData().toInt()),
+                static_cast<QSerialPort::StopBits>(ui->stopBitsBox->currentData().toInt()));
+
+    if (!started) {
+        QMessageBox::warning(this, tr("Warning!"), m_detector->errorString());
+        return;
+    }
+
+    ui->detectButton->setEnabled(false);
+    ui->applyButton->setEnabled(false);
+}
+
+void SettingsDialog::detected(bool ok)
+{
+    ui->detectButton->setText(tr("Detect"));
+    ui->detectButton->setEnabled(true);
+    ui->applyButton->setEnabled(true);
+
+    const AutoDetector::Result r = m_detector->result();
+    if (!ok) {
+        QMessageBox::warning(this, tr("Warning!"),
+                             tr("Could not detect the port parameters:\n%1")
+                             .arg(m_detector->errorString()));
+        return;
+    }
+
+    // A rate missing from the list goes to the custom entry.
+    const int idx = ui->baudRateBox->findData(r.baudRate);
+    if (-1 != idx) {
+        ui->baudRateBox->setCurrentIndex(idx);
+    } else {
+        ui->baudRateBox->setCurrentIndex(ui->baudRateBox->count() - 1);
+        ui->baudRateBox->setEditText(QString::number(r.baudRate));
+    }
+
+    if (!r.encoding.isEmpty())
+        ui->encodingBox->setCurrentText(r.encoding);
+
+    QMessageBox::information(this, tr("Detect"),
+                             tr("%1 baud, %2, %3% of %4 bytes look like text, found in %5 ms")
+                             .arg(r.baudRate)
+                             .arg(r.encoding.isEmpty() ? tr("ASCII") : r.encoding)
+                             .arg(qRound(r.quality * 100)).arg(r.sampleSize).arg(r.msecs));
+}
+
 void SettingsDialog::fillPortsParameters()
 {
     ui->baudRateBox->addItem(QLatin1String("2400"), QSerialPort::Baud2400);
@@ -155,57 +235,38 @@ void SettingsDialog::fillPortsParameters()
     ui->baudRateBox->addItem(QLatin1String("19200"), QSerialPort::Baud19200);
     ui->baudRateBox->addItem(QLatin1String("38400"), QSerialPort::Baud38400);
     ui->baudRateBox->addItem(QLatin1String("115200"), QSerialPort::Baud115200);
-
-    ui->baudRateBox->addItem(m_settings->value(QLatin1String("Baudrate")).toString().isEmpty() ?
-                                 QLatin1String("Custom") : m_settings->value(QLatin1String("Baudrate")).toString());
-
-    ui->baudRateBox->setCurrentIndex(m_settings->value(QLatin1String("BaudrateBoxIndex"), 4).toInt());
+    ui->baudRateBox->addItem(QLatin1String("Custom"));
 
     ui->dataBitsBox->addItem(QLatin1String("5"), QSerialPort::Data5);
     ui->dataBitsBox->addItem(QLatin1String("6"), QSerialPort::Data6);
     ui->dataBitsBox->addItem(QLatin1String("7"), QSerialPort::Data7);
     ui->dataBitsBox->addItem(QLatin1String("8"), QSerialPort::Data8);
 
-    ui->dataBitsBox->setCurrentText(m_settings->value(QLatin1String("DataBits"),
-                                                      QLatin1String("8")).toString());
-
     ui->parityBox->addItem(QLatin1String("None"), QSerialPort::NoParity);
     ui->parityBox->addItem(QLatin1String("Even"), QSerialPort::EvenParity);
     ui->parityBox->addItem(QLatin1String("Odd"), QSerialPort::OddParity);
     ui->parityBox->addItem(QLatin1String("Mark"), QSerialPort::MarkParity);
     ui->parityBox->addItem(QLatin1String("Space"), QSerialPort::SpaceParity);
 
-    ui->parityBox->setCurrentText(m_settings->value(QLatin1String("Parity"),
-                                                    QLatin1String("None")).toString());
-
     ui->stopBitsBox->addItem(QLatin1String("1"), QSerialPort::OneStop);
 #ifdef Q_OS_WIN
     ui->stopBitsBox->addItem(QLatin1String("1.5"), QSerialPort::OneAndHalfStop);
 #endif
     ui->stopBitsBox->addItem(QLatin1String("2"), QSerialPort::TwoStop);
 
-    ui->stopBitsBox->setCurrentText(m_settings->value(QLatin1String("StopBits"),
-                                                      QLatin1String("1")).toString());
-
     ui->flowControlBox->addItem(QLatin1String("None"), QSerialPort::NoFlowControl);
     ui->flowControlBox->addItem(QLatin1String("RTS/CTS"), QSerialPort::HardwareControl);
     ui->flowControlBox->addItem(QLatin1String("XON/XOFF"), QSerialPort::SoftwareControl);
 
-    ui->flowControlBox->setCurrentText(m_settings->value(QLatin1String("FlowControl"),
-                                                         QLatin1String("None")).toString());
-
     ui->encodingBox->addItem(QLatin1String("Windows 1251"));
     ui->encodingBox->addItem(QLatin1String("IBM 866"));
     ui->encodingBox->addItem(QLatin1String("UTF-8"));
 
-    ui->encodingBox->setCurrentText(m_settings->value(QLatin1String("Encoding"),
-                                                      QLatin1String("Windows 1251")).toString());
+    ui->controlCharsBox->addItem(QLatin1String("Keep"), TextSanitizer::KeepControlChars);
+    ui->controlCharsBox->addItem(QLatin1String("Show"), TextSanitizer::EscapeControlChars);
+    ui->controlCharsBox->addItem(QLatin1String("Collapse"), TextSanitizer::CollapseControlChars);
 
-    ui->dtrCheckBox->setChecked(m_settings->value("DTR", true).toBool());
-    ui->rtsCheckBox->setChecked(m_settings->value("RTS", false).toBool());
-
-    ui->saveFileCheckBox->setChecked(m_settings->value(QLatin1String("SaveDataOnExit"),
-                                                       false).toBool());
+    ui->pastePacingBox->addItems(BulkSender::pacingNames());
 }
 
 void SettingsDialog::fillPortsInfo()
@@ -230,10 +291,68 @@ void SettingsDialog::fillPortsInfo()
         ui->serialPortInfoListBox->addItem(list.first(), list);
     }
 
+//    ui->serialPortInfoListBox->addItem(tr("Custom"));
+}
+
+void SettingsDialog::load(const QString &fileName)
+{
+    delete m_settings;
+    m_settings = new QSettings(fileName, QSettings::IniFormat, this);
+
+    // The last entry holds the custom rate.
+    const QString baudRate = m_settings->value(QLatin1String("Baudrate")).toString();
+    ui->baudRateBox->setItemText(ui->baudRateBox->count() - 1,
+                                 baudRate.isEmpty() ? QLatin1String("Custom") : baudRate);
+
+    ui->baudRateBox->setCurrentIndex(m_settings->value(QLatin1String("BaudrateBoxIndex"), 4).toInt());
+
+    ui->dataBitsBox->setCurrentText(m_settings->value(QLatin1String("DataBits"),
+                                                      QLatin1String("8")).toString());
+
+    ui->parityBox->setCurrentText(m_settings->value(QLatin1String("Parity"),
+                                                    QLatin1String("None")).toString());
+
+    ui->stopBitsBox->setCurrentText(m_settings->value(QLatin1String("StopBits"),
+                                                      QLatin1String("1")).toString());
+
+    ui->flowControlBox->setCurrentText(m_settings->value(QLatin1String("FlowControl"),
+                                                         QLatin1String("None")).toString());
+
+    ui->encodingBox->setCurrentText(m_settings->value(QLatin1String("Encoding"),
+                                                      QLatin1String("Windows 1251")).toString());
+
+    ui->lineLengthBox->setValue(m_settings->value(QLatin1String("MaxLineLength"), 2048).toInt());
+
+    ui->controlCharsBox->setCurrentText(m_settings->value(QLatin1String("ControlCharacters"),
+                                                          QLatin1String("Show")).toString());
+
+    ui->pastePacingBox->setCurrentIndex(m_settings->value(QLatin1String("PastePacing"),
+                                                          BulkSender::NoPacing).toInt());
+    ui->pasteDelayBox->setValue(m_settings->value(QLatin1String("PasteDelay"), 10).toInt());
+    ui->pastePromptEdit->setText(m_settings->value(QLatin1String("PastePrompt")).toString());
+
+    ui->dtrCheckBox->setChecked(m_settings->value("DTR", true).toBool());
+    ui->rtsCheckBox->setChecked(m_settings->value("RTS", false).toBool());
+    ui->reconnectCheckBox->setChecked(m_settings->value(QLatin1String("Reconnect"), true).toBool());
+
+    ui->saveFileCheckBox->setChecked(m_settings->value(QLatin1String("SaveDataOnExit"),
+                                                       false).toBool());
+
+    ui->plotPatternsEdit->setPlainText(m_settings->value(QLatin1String("PlotPatterns"),
+                                                         QStringList(ValueExtractor::defaultPattern()))
+                                       .toStringList().join(QLatin1Char('\n')));
+
+    ui->bridgeGroupBox->setChecked(m_settings->value(QLatin1String("Bridge"), false).toBool());
+    ui->bridgeRemoteCheckBox->setChecked(m_settings->value(QLatin1String("BridgeRemote"),
+                                                           false).toBool());
+    ui->bridgePortBox->setValue(m_settings->value(QLatin1String("BridgePort"), 5555).toInt());
+    ui->bridgeSocketEdit->setText(m_settings->value(QLatin1String("BridgeSocket"),
+                                                    QLatin1String("SimpleTerminal")).toString());
+
     ui->serialPortInfoListBox->
             setCurrentText(m_settings->value("Port", ui->serialPortInfoListBox->currentText()).toString());
 
-//    ui->serialPortInfoListBox->addItem(tr("Custom"));
+    updateSettings();
 }
 
 void SettingsDialog::updateSettings()
@@ -275,7 +394,31 @@ void SettingsDialog::updateSettings()
 
     currentSettings.rtsEnabled = ui->rtsCheckBox->isChecked();
 
+    currentSettings.reconnect = ui->reconnectCheckBox->isChecked();
+
     currentSettings.textEncoding = ui->encodingBox->currentText();
 
+    currentSettings.maxLineLength = ui->lineLengthBox->value();
+
+    currentSettings.controlChars = static_cast<TextSanitizer::ControlChars>(
+                ui->controlCharsBox->itemData(ui->controlCharsBox->currentIndex()).toInt());
+
+    currentSettings.pastePacing = static_cast<BulkSender::Pacing>(ui->pastePacingBox->currentIndex());
+
+    currentSettings.pasteDelay = ui->pasteDelayBox->value();
+
+    currentSettings.pastePrompt = ui->pastePromptEdit->text();
+
     currentSettings.saveOnExit = ui->saveFileCheckBox->isChecked();
+
+    currentSettings.plotPatterns = ui->plotPatternsEdit->toPlainText()
+            .split(QLatin1Char('\n'), Qt::SkipEmptyParts);
+
+    currentSettings.bridgeEnabled = ui->bridgeGroupBox->isChecked();
+
+    currentSettings.bridgeRemote = ui->bridgeRemoteCheckBox->isChecked();
+
+    currentSettings.bridgePort = static_cast<quint16>(ui->bridgePortBox->value());
+
+    currentSettings.bridgeSocketName = ui->bridgeSocketEdit->text();
 }
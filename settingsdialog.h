@@ -39,6 +39,9 @@
 #include <QtSerialPort/QSerialPort>
 #include <QSettings>
 
+#include "bulksender.h"
+#include "textsanitizer.h"
+
 QT_USE_NAMESPACE
 
 QT_BEGIN_NAMESPACE
@@ -51,6 +54,8 @@ class QIntValidator;
 
 QT_END_NAMESPACE
 
+class AutoDetector;
+
 class SettingsDialog : public QDialog
 {
     Q_OBJECT
@@ -71,20 +76,39 @@ public:
         bool localEchoEnabled;
         bool dtrEnabled;
         bool rtsEnabled;
+        bool reconnect;
         bool saveOnExit;
         QString textEncoding;
+        int maxLineLength;
+        TextSanitizer::ControlChars controlChars;
+        BulkSender::Pacing pastePacing;
+        int pasteDelay;
+        QString pastePrompt;
+        QStringList plotPatterns;
+        bool bridgeEnabled;
+        bool bridgeRemote;
+        quint16 bridgePort;
+        QString bridgeSocketName;
     };
 
     explicit SettingsDialog(QWidget *parent = nullptr);
+    explicit SettingsDialog(const QString &fileName, QWidget *parent = nullptr);
     ~SettingsDialog();
 
     Settings settings() const;
 
+    // Reads the settings from an ini file into the dialog.
+    void load(const QString &fileName);
+
+    static QString fileName();
+
 private slots:
     void showPortInfo(int idx);
     void apply();
     void checkCustomBaudRatePolicy(int idx);
     void checkCustomDevicePathPolicy(int idx);
+    void detect();
+    void detected(bool ok);
 
 private:
     void fillPortsParameters();
@@ -95,6 +119,7 @@ private:
     Ui::SettingsDialog *ui = nullptr;
     QIntValidator *intValidator = nullptr;
     QSettings     *m_settings   = nullptr;
+    AutoDetector  *m_detector   = nullptr;
 
     Settings currentSettings;
 };
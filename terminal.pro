@@ -1,4 +1,4 @@
-QT += widgets serialport
+QT += widgets serialport network concurrent
 
 CONFIG += c++1z
 
@@ -32,16 +32,60 @@ SOURCES += \
     main.cpp \
     mainwindow.cpp \
     settingsdialog.cpp \
-    console.cpp
+    console.cpp \
+    samplebuffer.cpp \
+    valueextractor.cpp \
+    plotwidget.cpp \
+    serialbridge.cpp \
+    scrollback.cpp \
+    overloadguard.cpp \
+    latencyprobe.cpp \
+    latencydialog.cpp \
+    filetransfer.cpp \
+    xmodem.cpp \
+    zmodem.cpp \
+    filtermodel.cpp \
+    filterview.cpp \
+    autodetector.cpp \
+    reconnector.cpp \
+    textsanitizer.cpp \
+    glyphatlas.cpp \
+    expectresponder.cpp \
+    expectdialog.cpp \
+    tracer.cpp \
+    bulksender.cpp
 
 HEADERS += \
     mainwindow.h \
     settingsdialog.h \
-    console.h
+    console.h \
+    samplebuffer.h \
+    valueextractor.h \
+    plotwidget.h \
+    serialbridge.h \
+    scrollback.h \
+    overloadguard.h \
+    latencyprobe.h \
+    latencydialog.h \
+    filetransfer.h \
+    xmodem.h \
+    zmodem.h \
+    filtermodel.h \
+    filterview.h \
+    autodetector.h \
+    reconnector.h \
+    textsanitizer.h \
+    glyphatlas.h \
+    expectresponder.h \
+    expectdialog.h \
+    tracer.h \
+    bulksender.h
 
 FORMS += \
     mainwindow.ui \
-    settingsdialog.ui
+    settingsdialog.ui \
+    latencydialog.ui \
+    expectdialog.ui
 
 RESOURCES += \
     terminal.qrc
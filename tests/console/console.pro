@@ -0,0 +1,25 @@
+QT += testlib widgets serialport
+
+CONFIG += c++1z console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_console
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    tst_console.cpp \
+    ../../console.cpp \
+    ../../glyphatlas.cpp \
+    ../../scrollback.cpp \
+    ../../textsanitizer.cpp \
+    ../../tracer.cpp
+
+HEADERS += \
+    ../../console.h \
+    ../../glyphatlas.h \
+    ../../scrollback.h \
+    ../../textsanitizer.h \
+    ../../tracer.h
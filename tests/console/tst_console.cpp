@@ -0,0 +1,87 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QtTest>
+#include <QSerialPort>
+
+#include "console.h"
+#include "textsanitizer.h"
+
+class ConsoleTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void putData_data();
+    void putData();
+
+    void sanitizedLineEnds();
+};
+
+void ConsoleTest::putData_data()
+{
+    QTest::addColumn<QStringList>("chunks");
+    QTest::addColumn<QString>("text");
+
+    QTest::newRow("LF") << QStringList{ "one\ntwo" } << QString("one\ntwo");
+    QTest::newRow("CR LF") << QStringList{ "one\r\ntwo" } << QString("one\ntwo");
+    QTest::newRow("CR") << QStringList{ "one\rtwo" } << QString("one\ntwo");
+    QTest::newRow("LF CR") << QStringList{ "one\n\rtwo" } << QString("one\n\ntwo");
+    QTest::newRow("CR CR LF") << QStringList{ "one\r\r\ntwo" } << QString("one\n\ntwo");
+    QTest::newRow("CR LF split") << QStringList{ "one\r", "\ntwo" } << QString("one\ntwo");
+    QTest::newRow("CR at chunk end") << QStringList{ "one\r", "two" } << QString("one\ntwo");
+    QTest::newRow("CR chunks") << QStringList{ "one\r", "\r", "two" } << QString("one\n\ntwo");
+    QTest::newRow("LF after CR LF split") << QStringList{ "one\r", "\n", "\ntwo" } << QString("one\n\ntwo");
+    QTest::newRow("tab") << QStringList{ "a\tb\r\n\tc" } << QString("a       b\n        c");
+    QTest::newRow("tab after CR") << QStringList{ "abc\r", "\tx" } << QString("abc\n        x");
+    QTest::newRow("surrogate pair") << QStringList{ QString::fromUtf8("a\xF0\x9F\x98\x80\tb") }
+                                    << QString::fromUtf8("a\xEF\xBF\xBD      b");
+    QTest::newRow("lone surrogate") << QStringList{ QString(QChar(0xD800)) + "a" }
+                                    << QString::fromUtf8("\xEF\xBF\xBD" "a");
+}
+
+void ConsoleTest::putData()
+{
+    QFETCH(QStringList, chunks);
+    QFETCH(QString, text);
+
+    QSerialPort port;
+    Console console(nullptr, &port);
+    for (const QString &chunk : chunks)
+        console.putData(chunk);
+
+    console.selectAll();
+    QCOMPARE(console.selectedText(), text);
+}
+
+void ConsoleTest::sanitizedLineEnds()
+{
+    // A CR starts the line over, so the one after it is not cut.
+    TextSanitizer sanitizer;
+    sanitizer.setMaxLineLength(4);
+
+    QSerialPort port;
+    Console console(nullptr, &port);
+    console.putData(sanitizer.process(QStringLiteral("abc\r")));
+    console.putData(sanitizer.process(QStringLiteral("defg\r\nhijklm")));
+
+    console.selectAll();
+    QCOMPARE(console.selectedText(), QStringLiteral("abc\ndefg\nhijk\nlm"));
+}
+
+QTEST_MAIN(ConsoleTest)
+
+#include "tst_console.moc"
@@ -0,0 +1,22 @@
+QT += testlib
+QT -= gui
+
+CONFIG += c++1z console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_filetransfer
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    tst_filetransfer.cpp \
+    ../../filetransfer.cpp \
+    ../../xmodem.cpp \
+    ../../zmodem.cpp
+
+HEADERS += \
+    ../../filetransfer.h \
+    ../../xmodem.h \
+    ../../zmodem.h
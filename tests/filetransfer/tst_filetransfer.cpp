@@ -0,0 +1,344 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QtTest>
+#include <QProcess>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <functional>
+
+#include "filetransfer.h"
+
+namespace {
+
+const int TransferTimeout = 60000;
+
+// One end of an in-memory serial line. Written data reaches the other side
+// from the event loop, the way a port delivers it.
+class LinkEnd : public QIODevice
+{
+public:
+    LinkEnd() { open(QIODevice::ReadWrite | QIODevice::Unbuffered); }
+
+    std::function<void(const QByteArray &)> deliver;
+
+protected:
+    qint64 readData(char *, qint64) Q_DECL_OVERRIDE { return 0; }
+
+    qint64 writeData(const char *data, qint64 size) Q_DECL_OVERRIDE
+    {
+        const QByteArray bytes(data, int(size));
+        QMetaObject::invokeMethod(this, [this, bytes]() {
+            if (deliver)
+                deliver(bytes);
+            emit bytesWritten(bytes.size());
+        }, Qt::QueuedConnection);
+        return size;
+    }
+};
+
+// Random contents that do not end in the XMODEM padding character.
+QByteArray testData(int size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    quint32 seed = 12345;
+    for (char &c : data) {
+        seed = seed * 1103515245 + 12345;
+        c = char(seed >> 16);
+    }
+    if (size && 0x1A == data.at(size - 1))
+        data[size - 1] = 'x';
+    return data;
+}
+
+bool writeFile(const QString &fileName, const QByteArray &data)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::WriteOnly) && file.write(data) == data.size();
+}
+
+QByteArray readFile(const QString &fileName)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+struct Result {
+    bool done = false;
+    bool ok = false;
+    QString message;
+};
+
+void track(FileTransfer *transfer, Result *result)
+{
+    QObject::connect(transfer, &FileTransfer::finished, [result](bool ok, const QString &message) {
+        result->done = true;
+        result->ok = ok;
+        result->message = message;
+    });
+}
+
+} // namespace
+
+// The transfer protocols against each other over an in-memory line, against
+// an old checksum-only sender, and against lrzsz when it is installed.
+class FileTransferTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void loopback_data();
+    void loopback();
+
+    void checksumFallback();
+
+    void lrzszReceive_data();
+    void lrzszReceive();
+
+    void lrzszSend_data();
+    void lrzszSend();
+
+private:
+    void addProtocolRows();
+};
+
+void FileTransferTest::addProtocolRows()
+{
+    QTest::addColumn<int>("protocol");
+    QTest::addColumn<int>("size");
+
+    const QStringList names = FileTransfer::protocolNames();
+    for (int protocol = 0; protocol < names.size(); ++protocol) {
+        for (int size : { 1, 1000, 100000 })
+            QTest::newRow(qPrintable(names.at(protocol) + QLatin1Char('/') + QString::number(size)))
+                    << protocol << size;
+    }
+}
+
+void FileTransferTest::loopback_data()
+{
+    addProtocolRows();
+}
+
+void FileTransferTest::loopback()
+{
+    QFETCH(int, protocol);
+    QFETCH(int, size);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QByteArray data = testData(size);
+    const QString source = dir.filePath(QLatin1String("source.bin"));
+    QVERIFY(writeFile(source, data));
+    QVERIFY(QDir(dir.path()).mkdir(QLatin1String("in")));
+
+    LinkEnd senderEnd;
+    LinkEnd receiverEnd;
+    QScopedPointer<FileTransfer> sender(
+                FileTransfer::create(FileTransfer::Protocol(protocol), &senderEnd));
+    QScopedPointer<FileTransfer> receiver(
+                FileTransfer::create(FileTransfer::Protocol(protocol), &receiverEnd));
+
+    senderEnd.deliver = [&receiver](const QByteArray &bytes) { receiver->feed(bytes); };
+    receiverEnd.deliver = [&sender](const QByteArray &bytes) { sender->feed(bytes); };
+
+    Result sent;
+    Result received;
+    track(sender.data(), &sent);
+    track(receiver.data(), &received);
+
+    const QString target = receiver->isBatch()
+            ? dir.filePath(QLatin1String("in"))
+            : dir.filePath(QLatin1String("in/source.bin"));
+
+    sender->send(QStringList(source));
+    receiver->receive(target);
+
+    QTRY_VERIFY_WITH_TIMEOUT(sent.done && received.done, TransferTimeout);
+    QVERIFY2(sent.ok, qPrintable(sent.message));
+    QVERIFY2(received.ok, qPrintable(received.message));
+    QCOMPARE(readFile(dir.filePath(QLatin1String("in/source.bin"))), data);
+}
+
+// A sender from before CRC-16 ignores the 'C' polls and only starts on NAK.
+void FileTransferTest::checksumFallback()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    LinkEnd end;
+    QScopedPointer<FileTransfer> receiver(FileTransfer::create(FileTransfer::XModem1K, &end));
+
+    const QByteArray data = testData(200);
+    QByteArray fromReceiver;
+    int blocks = 0;
+
+    const auto block = [](quint8 number, QByteArray payload) {
+        payload = payload.leftJustified(128, 0x1A);
+        char sum = 0;
+        for (char c : payload)
+            sum = char(sum + c);
+        return QByteArray(1, 0x01) + char(number) + char(~number) + payload + sum;
+    };
+
+    end.deliver = [&](const QByteArray &bytes) {
+        fromReceiver += bytes;
+        for (char c : bytes) {
+            if (0x15 == c && 0 == blocks) {
+                ++blocks;
+                receiver->feed(block(1, data.left(128)));
+            } else if (0x06 == c && 1 == blocks) {
+                ++blocks;
+                receiver->feed(block(2, data.mid(128)));
+            } else if (0x06 == c && 2 == blocks) {
+                ++blocks;
+                receiver->feed(QByteArray(1, 0x04));
+            }
+        }
+    };
+
+    Result received;
+    track(receiver.data(), &received);
+
+    const QString target = dir.filePath(QLatin1String("received.bin"));
+    receiver->receive(target);
+
+    QTRY_VERIFY_WITH_TIMEOUT(received.done, TransferTimeout);
+    QVERIFY2(received.ok, qPrintable(received.message));
+    QVERIFY(fromReceiver.startsWith('C'));
+    QCOMPARE(readFile(target), data);
+}
+
+void FileTransferTest::lrzszReceive_data()
+{
+    addProtocolRows();
+}
+
+// sz sends, the transfer receives. lrzsz talks over its standard streams.
+void FileTransferTest::lrzszReceive()
+{
+    QFETCH(int, protocol);
+    QFETCH(int, size);
+
+    QString sz = QStandardPaths::findExecutable(QLatin1String("sz"));
+    if (sz.isEmpty())
+        sz = QStandardPaths::findExecutable(QLatin1String("lsz"));
+    if (sz.isEmpty())
+        QSKIP("lrzsz is not installed");
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QByteArray data = testData(size);
+    const QString source = dir.filePath(QLatin1String("source.bin"));
+    QVERIFY(writeFile(source, data));
+    QVERIFY(QDir(dir.path()).mkdir(QLatin1String("in")));
+
+    const QStringList modes = { QLatin1String("--xmodem"), QLatin1String("--ymodem"),
+                                QLatin1String("--zmodem") };
+    QStringList arguments = { QLatin1String("-q"), modes.at(protocol) };
+    if (FileTransfer::XModem1K == protocol)
+        arguments << QLatin1String("-k");
+    arguments << source;
+
+    QProcess process;
+    QScopedPointer<FileTransfer> receiver(
+                FileTransfer::create(FileTransfer::Protocol(protocol), &process));
+    connect(&process, &QProcess::readyReadStandardOutput, [&]() {
+        receiver->feed(process.readAllStandardOutput());
+    });
+
+    Result received;
+    track(receiver.data(), &received);
+
+    process.start(sz, arguments);
+    QVERIFY(process.waitForStarted());
+
+    receiver->receive(receiver->isBatch() ? dir.filePath(QLatin1String("in"))
+                                          : dir.filePath(QLatin1String("in/source.bin")));
+
+    QTRY_VERIFY_WITH_TIMEOUT(received.done, TransferTimeout);
+    QVERIFY2(received.ok, qPrintable(received.message));
+    QVERIFY(process.waitForFinished());
+    QCOMPARE(process.exitCode(), 0);
+    QCOMPARE(readFile(dir.filePath(QLatin1String("in/source.bin"))), data);
+}
+
+void FileTransferTest::lrzszSend_data()
+{
+    addProtocolRows();
+}
+
+// The transfer sends, rz receives into its working directory.
+void FileTransferTest::lrzszSend()
+{
+    QFETCH(int, protocol);
+    QFETCH(int, size);
+
+    QString rz = QStandardPaths::findExecutable(QLatin1String("rz"));
+    if (rz.isEmpty())
+        rz = QStandardPaths::findExecutable(QLatin1String("lrz"));
+    if (rz.isEmpty())
+        QSKIP("lrzsz is not installed");
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QByteArray data = testData(size);
+    const QString source = dir.filePath(QLatin1String("source.bin"));
+    QVERIFY(writeFile(source, data));
+    QVERIFY(QDir(dir.path()).mkdir(QLatin1String("in")));
+
+    const QStringList modes = { QLatin1String("--xmodem"), QLatin1String("--ymodem"),
+                                QLatin1String("--zmodem") };
+    QStringList arguments = { QLatin1String("-q"), modes.at(protocol) };
+    // XMODEM carries no name, rz is given one.
+    if (FileTransfer::XModem1K == protocol)
+        arguments << QLatin1String("source.bin");
+
+    QProcess process;
+    process.setWorkingDirectory(dir.filePath(QLatin1String("in")));
+    QScopedPointer<FileTransfer> sender(
+                FileTransfer::create(FileTransfer::Protocol(protocol), &process));
+    connect(&process, &QProcess::readyReadStandardOutput, [&]() {
+        sender->feed(process.readAllStandardOutput());
+    });
+
+    Result sent;
+    track(sender.data(), &sent);
+
+    process.start(rz, arguments);
+    QVERIFY(process.waitForStarted());
+    sender->send(QStringList(source));
+
+    QTRY_VERIFY_WITH_TIMEOUT(sent.done, TransferTimeout);
+    QVERIFY2(sent.ok, qPrintable(sent.message));
+    QVERIFY(process.waitForFinished());
+    QCOMPARE(process.exitCode(), 0);
+
+    // Without a length XMODEM leaves the padding of the last block.
+    QByteArray result = readFile(dir.filePath(QLatin1String("in/source.bin")));
+    if (FileTransfer::XModem1K == protocol) {
+        while (result.size() > data.size() && 0x1A == result.at(result.size() - 1))
+            result.chop(1);
+    }
+    QCOMPARE(result, data);
+}
+
+QTEST_GUILESS_MAIN(FileTransferTest)
+
+#include "tst_filetransfer.moc"
@@ -0,0 +1,18 @@
+QT += testlib network
+QT -= gui
+
+CONFIG += c++1z console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_serialbridge
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    tst_serialbridge.cpp \
+    ../../serialbridge.cpp
+
+HEADERS += \
+    ../../serialbridge.h
@@ -0,0 +1,156 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QtTest>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include "serialbridge.h"
+
+namespace {
+
+const int Timeout = 5000;
+
+// A socket name no other run of the test is using.
+QString uniqueName()
+{
+    return QStringLiteral("tst_serialbridge_%1_%2").arg(QCoreApplication::applicationPid())
+            .arg(QDateTime::currentMSecsSinceEpoch());
+}
+
+// A TCP port nobody listens on at the moment.
+quint16 freePort()
+{
+    QTcpServer server;
+    return server.listen(QHostAddress::LocalHost) ? server.serverPort() : 0;
+}
+
+// Sends data both ways between the bridge and a connected client.
+void roundTrip(SerialBridge &bridge, QIODevice &client)
+{
+    QTRY_COMPARE_WITH_TIMEOUT(bridge.clientCount(), 1, Timeout);
+
+    // The connections go away with it on every return.
+    QObject context;
+
+    QByteArray toClient;
+    QObject::connect(&client, &QIODevice::readyRead, &context, [&]() { toClient += client.readAll(); });
+    bridge.broadcast("from the port");
+    QTRY_COMPARE_WITH_TIMEOUT(toClient, QByteArray("from the port"), Timeout);
+
+    QByteArray toPort;
+    QObject::connect(&bridge, &SerialBridge::dataReceived, &context,
+                     [&](const QByteArray &data) { toPort += data; });
+    client.write("to the port");
+    QTRY_COMPARE_WITH_TIMEOUT(toPort, QByteArray("to the port"), Timeout);
+}
+
+} // namespace
+
+class SerialBridgeTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void tcpRoundTrip();
+    void localRoundTrip();
+    void localNameInUse();
+    void staleLocalName();
+};
+
+void SerialBridgeTest::tcpRoundTrip()
+{
+    const quint16 port = freePort();
+    QVERIFY(port);
+
+    SerialBridge bridge;
+    QVERIFY2(bridge.listen(port, false, QString()), qPrintable(bridge.errorString()));
+
+    QTcpSocket client;
+    client.connectToHost(QHostAddress::LocalHost, port);
+    QVERIFY(client.waitForConnected(Timeout));
+
+    roundTrip(bridge, client);
+
+    client.disconnectFromHost();
+    QTRY_COMPARE_WITH_TIMEOUT(bridge.clientCount(), 0, Timeout);
+}
+
+void SerialBridgeTest::localRoundTrip()
+{
+    const QString name = uniqueName();
+
+    SerialBridge bridge;
+    QVERIFY2(bridge.listen(0, false, name), qPrintable(bridge.errorString()));
+    QVERIFY(bridge.isListening());
+
+    QLocalSocket client;
+    client.connectToServer(name);
+    QVERIFY(client.waitForConnected(Timeout));
+
+    roundTrip(bridge, client);
+
+    client.disconnectFromServer();
+    QTRY_COMPARE_WITH_TIMEOUT(bridge.clientCount(), 0, Timeout);
+}
+
+void SerialBridgeTest::localNameInUse()
+{
+    const QString name = uniqueName();
+
+    QLocalServer other;
+    QVERIFY(other.listen(name));
+
+    // The other server answers the probe, so its socket must stay.
+    SerialBridge bridge;
+    QSignalSpy failed(&bridge, &SerialBridge::listenFailed);
+    QVERIFY(bridge.listen(0, false, name));
+    QTRY_COMPARE_WITH_TIMEOUT(failed.count(), 1, Timeout);
+    QVERIFY(!bridge.isListening());
+    QVERIFY(other.isListening());
+}
+
+void SerialBridgeTest::staleLocalName()
+{
+#ifdef Q_OS_UNIX
+    // A socket file left behind by a crashed instance.
+    const QString name = uniqueName();
+    const QString path = QDir(QDir::tempPath()).absoluteFilePath(name);
+    {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+
+    SerialBridge bridge;
+    QSignalSpy failed(&bridge, &SerialBridge::listenFailed);
+    QVERIFY(bridge.listen(0, false, name));
+    QTRY_VERIFY_WITH_TIMEOUT(bridge.isListening(), Timeout);
+    QVERIFY(failed.isEmpty());
+
+    QLocalSocket client;
+    client.connectToServer(name);
+    QVERIFY(client.waitForConnected(Timeout));
+    roundTrip(bridge, client);
+#else
+    QSKIP("Only Unix leaves the socket of a crashed server behind");
+#endif
+}
+
+QTEST_GUILESS_MAIN(SerialBridgeTest)
+
+#include "tst_serialbridge.moc"
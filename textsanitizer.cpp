@@ -0,0 +1,108 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <limits>
+
+#include "textsanitizer.h"
+#include "tracer.h"
+
+namespace {
+
+// Tab is left to the console, CR ends a line there like LF.
+inline bool isControl(ushort c)
+{
+    return (c < 0x20 && c != '\t' && c != '\n' && c != '\r') || 0x7f == c;
+}
+
+// Decoders turn bytes that are not text into the replacement character.
+inline bool isGarbage(ushort c)
+{
+    return isControl(c) || QChar::ReplacementCharacter == c;
+}
+
+// The Control Pictures block has a symbol for every C0 character and DEL.
+inline QChar picture(ushort c)
+{
+    return QChar(0x7f == c ? 0x2421 : 0x2400 + c);
+}
+
+} // namespace
+
+QString TextSanitizer::process(const QString &text)
+{
+    TRACE_SCOPE("TextSanitizer::process");
+
+    if (KeepControlChars == m_mode && 0 == m_maxLineLength)
+        return text;
+
+    QString out;
+    out.reserve(text.size() + (m_maxLineLength ? text.size() / m_maxLineLength : 0) + 1);
+
+    const QChar *p = text.constData();
+    const int size = text.size();
+    const int limit = m_maxLineLength ? m_maxLineLength : std::numeric_limits<int>::max();
+
+    int i = 0;
+    while (i < size) {
+        // Copy the plain run up to the next special character or the limit.
+        const int room = limit - m_column;
+        int end = i;
+        while (end < size && end - i < room) {
+            const ushort c = p[end].unicode();
+            if ('\n' == c || '\r' == c || (KeepControlChars != m_mode && isGarbage(c)))
+                break;
+            ++end;
+        }
+
+        if (end > i) {
+            out.append(p + i, end - i);
+            m_column += end - i;
+            m_inRun = false;
+            i = end;
+            continue;
+        }
+
+        if (m_column >= limit && QLatin1Char('\n') != p[i] && QLatin1Char('\r') != p[i]) {
+            out += QLatin1Char('\n');
+            m_column = 0;
+            continue;
+        }
+
+        const ushort c = p[i++].unicode();
+        if ('\n' == c || '\r' == c) {
+            out += QChar(c);
+            m_column = 0;
+            m_inRun = false;
+        } else if (CollapseControlChars == m_mode) {
+            if (!m_inRun) {
+                out += QChar(QChar::ReplacementCharacter);
+                ++m_column;
+                m_inRun = true;
+            }
+        } else {
+            out += isControl(c) ? picture(c) : QChar(c);
+            ++m_column;
+        }
+    }
+
+    return out;
+}
+
+void TextSanitizer::reset()
+{
+    m_column = 0;
+    m_inRun = false;
+}
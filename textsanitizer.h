@@ -0,0 +1,51 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef TEXTSANITIZER_H
+#define TEXTSANITIZER_H
+
+#include <QString>
+
+// Makes received text safe to lay out. Lines longer than the limit are cut
+// into segments, so no paragraph grows without bounds however long the
+// device goes without a line end, and control characters are either made
+// visible or a run of them is shown as a single mark.
+class TextSanitizer
+{
+public:
+    enum ControlChars {
+        KeepControlChars,
+        EscapeControlChars,
+        CollapseControlChars
+    };
+
+    void setMaxLineLength(int length) { m_maxLineLength = qMax(0, length); }
+    int maxLineLength() const { return m_maxLineLength; }
+
+    void setControlChars(ControlChars mode) { m_mode = mode; }
+    ControlChars controlChars() const { return m_mode; }
+
+    QString process(const QString &text);
+    void reset();
+
+private:
+    int m_maxLineLength = 0;
+    ControlChars m_mode = KeepControlChars;
+    int  m_column = 0;
+    bool m_inRun  = false;
+};
+
+#endif // TEXTSANITIZER_H
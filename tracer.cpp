@@ -0,0 +1,161 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QIODevice>
+#include <QMutex>
+#include <QTextStream>
+#include <QThread>
+#include <QVector>
+
+#include "tracer.h"
+
+namespace {
+
+// Spans kept per thread, the oldest ones are overwritten.
+const int BufferCapacity = 1 << 18;
+
+struct Event {
+    const char *name;
+    qint64 begin;
+    qint64 end;
+};
+
+struct Buffer {
+    QMutex mutex;
+    QVector<Event> events;
+    int next = 0;
+    QString threadName;
+};
+
+struct Registry {
+    ~Registry() { qDeleteAll(buffers); }
+
+    QMutex mutex;
+    QVector<Buffer *> buffers;
+};
+
+Registry &registry()
+{
+    static Registry r;
+    return r;
+}
+
+thread_local Buffer *t_buffer = nullptr;
+
+Buffer *threadBuffer()
+{
+    if (t_buffer)
+        return t_buffer;
+
+    Buffer *buffer = new Buffer;
+    QThread *thread = QThread::currentThread();
+    buffer->threadName = thread->objectName();
+
+    Registry &r = registry();
+    QMutexLocker lock(&r.mutex);
+
+    if (QCoreApplication::instance() && QCoreApplication::instance()->thread() == thread)
+        buffer->threadName = QStringLiteral("Main");
+    else if (buffer->threadName.isEmpty())
+        buffer->threadName = QStringLiteral("Thread %1").arg(r.buffers.size() + 1);
+
+    r.buffers.append(buffer);
+    t_buffer = buffer;
+    return buffer;
+}
+
+} // namespace
+
+std::atomic<bool> Tracer::s_enabled(false);
+
+void Tracer::setEnabled(bool enabled)
+{
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+qint64 Tracer::now()
+{
+    static const QElapsedTimer clock = []() {
+        QElapsedTimer t;
+        t.start();
+        return t;
+    }();
+
+    return clock.nsecsElapsed();
+}
+
+void Tracer::record(const char *name, qint64 begin, qint64 end)
+{
+    Buffer *buffer = threadBuffer();
+
+    // Only the writer ever waits for this lock.
+    QMutexLocker lock(&buffer->mutex);
+    const Event event = { name, begin, end };
+
+    if (buffer->events.size() < BufferCapacity) {
+        buffer->events.append(event);
+    } else {
+        buffer->events[buffer->next] = event;
+        buffer->next = (buffer->next + 1) % BufferCapacity;
+    }
+}
+
+void Tracer::clear()
+{
+    Registry &r = registry();
+    QMutexLocker lock(&r.mutex);
+
+    for (Buffer *buffer : r.buffers) {
+        QMutexLocker bufferLock(&buffer->mutex);
+        buffer->events.clear();
+        buffer->next = 0;
+    }
+}
+
+bool Tracer::write(QIODevice *device)
+{
+    QTextStream out(device);
+    out.setCodec("UTF-8");
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+    Registry &r = registry();
+    QMutexLocker lock(&r.mutex);
+
+    for (int tid = 1; tid <= r.buffers.size(); ++tid) {
+        Buffer *buffer = r.buffers.at(tid - 1);
+        QMutexLocker bufferLock(&buffer->mutex);
+
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+            << ",\"args\":{\"name\":\"" << buffer->threadName << "\"}}";
+
+        // Timestamps are in microseconds, the fraction keeps nanoseconds.
+        const int count = buffer->events.size();
+        for (int i = 0; i < count; ++i) {
+            const Event &e = buffer->events.at((buffer->next + i) % count);
+            out << ",\n{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+                << ",\"ts\":" << QString::number(e.begin / 1000.0, 'f', 3)
+                << ",\"dur\":" << QString::number((e.end - e.begin) / 1000.0, 'f', 3) << '}';
+        }
+
+        out << (tid < r.buffers.size() ? ",\n" : "\n");
+    }
+
+    out << "]}\n";
+    out.flush();
+    return QTextStream::Ok == out.status();
+}
@@ -0,0 +1,73 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QtGlobal>
+#include <atomic>
+
+QT_BEGIN_NAMESPACE
+class QIODevice;
+QT_END_NAMESPACE
+
+// Timing spans of the data path, written out in the Chrome trace format that
+// chrome://tracing and Perfetto read. Every thread records into a buffer of
+// its own. While tracing is off a span costs one relaxed atomic load.
+class Tracer
+{
+public:
+    // Names must be string literals, only the pointer is kept.
+    class Scope
+    {
+    public:
+        explicit Scope(const char *name) :
+            m_name(name),
+            m_begin(Tracer::isEnabled() ? Tracer::now() : -1)
+        {
+        }
+
+        ~Scope()
+        {
+            if (m_begin >= 0)
+                Tracer::record(m_name, m_begin, Tracer::now());
+        }
+
+    private:
+        Q_DISABLE_COPY(Scope)
+
+        const char *m_name;
+        qint64 m_begin;
+    };
+
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+    static void setEnabled(bool enabled);
+    static void clear();
+
+    static bool write(QIODevice *device);
+
+    static qint64 now();
+    static void record(const char *name, qint64 begin, qint64 end);
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) Tracer::Scope TRACE_CONCAT(traceScope, __LINE__)(name)
+
+#endif // TRACER_H
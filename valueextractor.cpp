@@ -0,0 +1,136 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QDebug>
+
+#include "samplebuffer.h"
+#include "valueextractor.h"
+
+namespace {
+
+// Lines longer than that are not measurements, do not let them pile up.
+const int MaxLineLength = 4096;
+
+} // namespace
+
+ValueExtractor::ValueExtractor(SampleStore *store) :
+    m_store(store)
+{
+}
+
+bool ValueExtractor::setPatterns(const QStringList &patterns)
+{
+    bool valid = true;
+    m_patterns.clear();
+
+    for (const QString &pattern : patterns) {
+        QRegularExpression re(pattern);
+        if (!re.isValid()) {
+            qWarning() << "Invalid plot pattern" << pattern << ':' << re.errorString();
+            valid = false;
+            continue;
+        }
+
+        re.optimize();
+        m_patterns.append(re);
+    }
+
+    return valid;
+}
+
+QStringList ValueExtractor::patterns() const
+{
+    QStringList list;
+    for (const QRegularExpression &re : m_patterns)
+        list << re.pattern();
+
+    return list;
+}
+
+void ValueExtractor::feed(const QString &text)
+{
+    if (m_patterns.isEmpty())
+        return;
+
+    int from = 0;
+    for (int end = text.indexOf(QLatin1Char('\n')); end >= 0;
+         end = text.indexOf(QLatin1Char('\n'), from)) {
+        if (m_line.isEmpty()) {
+            processLine(text.mid(from, end - from));
+        } else {
+            m_line.append(text.midRef(from, end - from));
+            processLine(m_line);
+            m_line.clear();
+        }
+        from = end + 1;
+    }
+
+    m_line.append(text.midRef(from));
+    if (m_line.size() > MaxLineLength)
+        m_line.clear();
+}
+
+void ValueExtractor::reset()
+{
+    m_line.clear();
+}
+
+QString ValueExtractor::defaultPattern()
+{
+    return QStringLiteral("([A-Za-z_][\\w.]*)\\s*[=:]\\s*([-+]?\\d+(?:\\.\\d+)?(?:[eE][-+]?\\d+)?)");
+}
+
+void ValueExtractor::processLine(const QString &line)
+{
+    for (const QRegularExpression &re : m_patterns) {
+        const QStringList names = re.namedCaptureGroups();
+        const int groups = re.captureCount();
+
+        QRegularExpressionMatchIterator it = re.globalMatch(line);
+        while (it.hasNext()) {
+            const QRegularExpressionMatch match = it.next();
+            bool ok = false;
+
+            if (names.size() > 1 && !names.join(QString()).isEmpty()) {
+                for (int i = 1; i <= groups; ++i) {
+                    if (names.at(i).isEmpty())
+                        continue;
+
+                    const double value = match.capturedRef(i).toDouble(&ok);
+                    if (ok)
+                        store(names.at(i), value);
+                }
+            } else if (groups >= 2) {
+                const double value = match.capturedRef(2).toDouble(&ok);
+                if (ok)
+                    store(match.captured(1), value);
+            } else {
+                const double value = match.capturedRef(groups).toDouble(&ok);
+                if (ok)
+                    store(re.pattern(), value);
+            }
+        }
+    }
+}
+
+void ValueExtractor::store(const QString &name, double value)
+{
+    // The plot is redrawn only when a value was added.
+    if (SampleSeries *series = m_store->series(name)) {
+        series->append(value);
+        m_store->touch();
+    }
+}
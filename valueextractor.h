@@ -0,0 +1,55 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef VALUEEXTRACTOR_H
+#define VALUEEXTRACTOR_H
+
+#include <QRegularExpression>
+#include <QStringList>
+#include <QVector>
+
+class SampleStore;
+
+// Splits the received text into lines and appends every number matched by
+// the user patterns to the sample store.
+//
+// Naming of the extracted values depends on the pattern:
+//  - named groups, e.g. "T=(?<temp>\d+)", give one series per group;
+//  - two unnamed groups are taken as (name, value), e.g. "(\w+)=(\d+)";
+//  - a single group or a plain match is named after the pattern itself.
+class ValueExtractor
+{
+public:
+    explicit ValueExtractor(SampleStore *store);
+
+    bool setPatterns(const QStringList &patterns);
+    QStringList patterns() const;
+
+    void feed(const QString &text);
+    void reset();
+
+    static QString defaultPattern();
+
+private:
+    void processLine(const QString &line);
+    void store(const QString &name, double value);
+
+    SampleStore *m_store = nullptr;
+    QVector<QRegularExpression> m_patterns;
+    QString m_line;
+};
+
+#endif // VALUEEXTRACTOR_H
@@ -0,0 +1,476 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QDateTime>
+#include <QFileInfo>
+
+#include "xmodem.h"
+
+namespace {
+
+const char SOH = 0x01;
+const char STX = 0x02;
+const char EOT = 0x04;
+const char ACK = 0x06;
+const char NAK = 0x15;
+const char CAN = 0x18;
+const char SUB = 0x1A;
+const char CRC = 'C';
+
+const int MaxRetries   = 10;
+const int StartTimeout = 60000;
+const int BlockTimeout = 10000;
+const int PollInterval = 3000;
+
+// 'C' polls before the receiver falls back to checksums and polls with NAK.
+const int CrcPolls = 3;
+
+} // namespace
+
+XModemTransfer::XModemTransfer(bool batch, QIODevice *device, QObject *parent) :
+    FileTransfer(device, parent),
+    m_batch(batch)
+{
+}
+
+void XModemTransfer::send(const QStringList &fileNames)
+{
+    start();
+    m_queue = m_batch ? fileNames : fileNames.mid(0, 1);
+    for (const QString &fileName : m_queue)
+        m_total += QFileInfo(fileName).size();
+
+    m_state = SendWaitStart;
+    m_tries = 0;
+    m_cancelSeen = false;
+    restartTimeout(StartTimeout);
+}
+
+void XModemTransfer::receive(const QString &path)
+{
+    start();
+    m_path = path;
+    m_rx.clear();
+    m_pending.clear();
+    m_state = Receive;
+    m_number = 1;
+    m_tries = 0;
+    m_eots  = 0;
+    m_files = 0;
+    m_expectHeader = m_batch;
+    m_started = false;
+    m_crc = true;
+    m_cancelSeen = false;
+
+    if (!m_batch) {
+        m_file.setFileName(path);
+        if (!m_file.open(QIODevice::WriteOnly)) {
+            finish(false, m_file.errorString());
+            return;
+        }
+    }
+
+    reply(CRC);
+    restartTimeout(PollInterval);
+}
+
+void XModemTransfer::feed(const QByteArray &data)
+{
+    if (!isRunning())
+        return;
+
+    if (Receive == m_state) {
+        m_rx.append(data);
+        feedReceiver();
+        return;
+    }
+
+    for (char c : data) {
+        feedSender(c);
+        if (!isRunning())
+            return;
+    }
+}
+
+void XModemTransfer::timeout()
+{
+    if (Receive == m_state) {
+        if (++m_tries > MaxRetries) {
+            finish(false, tr("No data from the sender"));
+            return;
+        }
+
+        // The sender is polled with 'C' until it starts, an old sender that
+        // only knows checksums is polled with NAK after a few tries. Later a
+        // lost block is requested again.
+        m_rx.clear();
+        if (m_started) {
+            ++m_retries;
+            reply(NAK);
+            restartTimeout(BlockTimeout);
+        } else {
+            if (m_tries >= CrcPolls)
+                m_crc = false;
+            reply(m_crc ? CRC : NAK);
+            restartTimeout(PollInterval);
+        }
+        return;
+    }
+
+    if (SendWaitStart == m_state || SendWaitDataStart == m_state) {
+        finish(false, tr("No response from the receiver"));
+        return;
+    }
+
+    retry();
+}
+
+void XModemTransfer::feedSender(char c)
+{
+    if (CAN == c) {
+        if (m_cancelSeen) {
+            finish(false, tr("Cancelled by the receiver"));
+            return;
+        }
+        m_cancelSeen = true;
+        return;
+    }
+    m_cancelSeen = false;
+
+    switch (m_state) {
+    case SendWaitStart:
+        if (CRC == c || NAK == c) {
+            m_crc = CRC == c;
+            m_tries = 0;
+            if (m_batch)
+                sendHeader();
+            else
+                startFile();
+        }
+        break;
+
+    case SendWaitHeaderAck:
+        if (ACK == c) {
+            m_state = m_file.isOpen() ? SendWaitDataStart : Idle;
+            if (Idle == m_state)
+                finish(true, tr("%n file(s) sent", nullptr, m_files));
+            else
+                restartTimeout(BlockTimeout);
+        } else if (NAK == c) {
+            retry();
+        }
+        break;
+
+    case SendWaitDataStart:
+        if (CRC == c || NAK == c) {
+            m_crc = CRC == c;
+            m_number = 1;
+            sendNextBlock();
+        }
+        break;
+
+    case SendWaitBlockAck:
+        if (ACK == c) {
+            addBytes(m_blockData);
+            ++m_number;
+            m_tries = 0;
+            sendNextBlock();
+        } else if (NAK == c) {
+            retry();
+        }
+        break;
+
+    case SendWaitEotAck:
+        if (ACK == c) {
+            m_file.close();
+            ++m_files;
+            m_tries = 0;
+            if (m_batch) {
+                m_state = SendWaitStart;
+                restartTimeout(BlockTimeout);
+            } else {
+                finish(true, tr("File sent"));
+            }
+        } else if (NAK == c) {
+            retry();
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void XModemTransfer::startFile()
+{
+    m_file.setFileName(m_queue.takeFirst());
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        finish(false, m_file.errorString());
+        return;
+    }
+
+    m_number = 1;
+    sendNextBlock();
+}
+
+void XModemTransfer::sendHeader()
+{
+    // Block 0 names the file, an empty one ends the batch.
+    QByteArray header;
+    if (!m_queue.isEmpty()) {
+        m_file.setFileName(m_queue.takeFirst());
+        if (!m_file.open(QIODevice::ReadOnly)) {
+            finish(false, m_file.errorString());
+            return;
+        }
+
+        const QFileInfo info(m_file);
+        header = info.fileName().toLocal8Bit() + '\0' + QByteArray::number(info.size())
+                + ' ' + QByteArray::number(info.lastModified().toMSecsSinceEpoch() / 1000, 8);
+    }
+
+    m_blockData = 0;
+    sendFrame(makeBlock(0, header), SendWaitHeaderAck);
+}
+
+void XModemTransfer::sendNextBlock()
+{
+    if (m_file.atEnd()) {
+        sendFrame(QByteArray(1, EOT), SendWaitEotAck);
+        return;
+    }
+
+    // A short tail goes out in a small block to save the padding.
+    const qint64 left = m_file.size() - m_file.pos();
+    const QByteArray data = m_file.read(m_crc && left > 128 ? 1024 : 128);
+    m_blockData = data.size();
+
+    sendFrame(makeBlock(m_number, data), SendWaitBlockAck);
+}
+
+void XModemTransfer::sendFrame(const QByteArray &frame, State state)
+{
+    m_frame = frame;
+    m_state = state;
+    write(frame);
+    restartTimeout(BlockTimeout);
+}
+
+void XModemTransfer::retry()
+{
+    ++m_retries;
+    if (++m_tries > MaxRetries) {
+        abort(tr("Too many retries"));
+        return;
+    }
+
+    write(m_frame);
+    restartTimeout(BlockTimeout);
+}
+
+QByteArray XModemTransfer::makeBlock(quint8 number, QByteArray data) const
+{
+    const int size = data.size() > 128 ? 1024 : 128;
+    data = data.leftJustified(size, number ? SUB : '\0');
+
+    QByteArray block;
+    block.reserve(size + 5);
+    block.append(128 == size ? SOH : STX);
+    block.append(char(number));
+    block.append(char(~number));
+    block.append(data);
+
+    if (m_crc) {
+        const quint16 crc = crc16(data.constData(), size);
+        block.append(char(crc >> 8));
+        block.append(char(crc & 0xFF));
+    } else {
+        char sum = 0;
+        for (char c : data)
+            sum = char(sum + c);
+        block.append(sum);
+    }
+
+    return block;
+}
+
+void XModemTransfer::feedReceiver()
+{
+    while (!m_rx.isEmpty() && isRunning()) {
+        const char c = m_rx.at(0);
+
+        if (SOH == c || STX == c) {
+            const int size = SOH == c ? 128 : 1024;
+            const int length = 3 + size + (m_crc ? 2 : 1);
+            if (m_rx.size() < length)
+                return;
+
+            const quint8 number = quint8(m_rx.at(1));
+            if (quint8(number ^ quint8(m_rx.at(2))) != 0xFF) {
+                m_rx.remove(0, 1);
+                continue;
+            }
+
+            const QByteArray data = m_rx.mid(3, size);
+            bool valid;
+            if (m_crc) {
+                const quint16 crc = quint16((quint8(m_rx.at(3 + size)) << 8)
+                                            | quint8(m_rx.at(4 + size)));
+                valid = crc16(data.constData(), size) == crc;
+            } else {
+                char sum = 0;
+                for (char d : data)
+                    sum = char(sum + d);
+                valid = sum == m_rx.at(3 + size);
+            }
+            m_rx.remove(0, length);
+
+            if (!valid) {
+                ++m_errors;
+                ++m_retries;
+                m_rx.clear();
+                reply(NAK);
+                restartTimeout(BlockTimeout);
+                return;
+            }
+
+            m_started = true;
+            m_tries = 0;
+            restartTimeout(BlockTimeout);
+            receiveBlock(number, data);
+        } else if (EOT == c) {
+            m_rx.remove(0, 1);
+            receiveEot();
+        } else if (CAN == c) {
+            if (m_rx.size() < 2)
+                return;
+            if (CAN == m_rx.at(1)) {
+                finish(false, tr("Cancelled by the sender"));
+                return;
+            }
+            m_rx.remove(0, 1);
+        } else {
+            m_rx.remove(0, 1);
+        }
+    }
+}
+
+void XModemTransfer::receiveBlock(quint8 number, const QByteArray &data)
+{
+    if (m_expectHeader) {
+        if (0 == number)
+            receiveHeader(data);
+        else
+            reply(NAK);
+        return;
+    }
+
+    if (number == quint8(m_number - 1)) {
+        // Our ACK got lost, the sender repeats the block.
+        reply(ACK);
+        return;
+    }
+
+    if (number != m_number) {
+        abort(tr("Block sequence lost"));
+        return;
+    }
+
+    if (m_batch) {
+        const qint64 size = m_remaining < 0 ? data.size() : qMin<qint64>(m_remaining, data.size());
+        m_file.write(data.constData(), size);
+        if (m_remaining >= 0)
+            m_remaining -= size;
+        addBytes(size);
+    } else {
+        // The last block is held back to strip its padding at the end.
+        m_file.write(m_pending);
+        addBytes(m_pending.size());
+        m_pending = data;
+    }
+
+    ++m_number;
+    reply(ACK);
+}
+
+void XModemTransfer::receiveHeader(const QByteArray &data)
+{
+    const int nameEnd = data.indexOf('\0');
+    const QByteArray name = data.left(nameEnd);
+
+    if (name.isEmpty()) {
+        reply(ACK);
+        finish(true, tr("%n file(s) received", nullptr, m_files));
+        return;
+    }
+
+    const QList<QByteArray> fields = data.mid(nameEnd + 1).split(' ');
+    bool ok = false;
+    m_remaining = fields.value(0).toLongLong(&ok);
+    if (!ok)
+        m_remaining = -1;
+
+    m_total += qMax<qint64>(0, m_remaining);
+
+    m_file.setFileName(uniqueFileName(m_path, QString::fromLocal8Bit(name)));
+    if (!m_file.open(QIODevice::WriteOnly)) {
+        abort(m_file.errorString());
+        return;
+    }
+
+    m_expectHeader = false;
+    m_number = 1;
+    m_eots = 0;
+    reply(ACK);
+    reply(m_crc ? CRC : NAK);
+}
+
+void XModemTransfer::receiveEot()
+{
+    if (m_batch) {
+        if (m_expectHeader)
+            return;
+
+        // The first EOT is confirmed with NAK in case it was line noise.
+        if (0 == m_eots++) {
+            reply(NAK);
+            return;
+        }
+
+        m_file.close();
+        ++m_files;
+        m_expectHeader = true;
+        reply(ACK);
+        reply(m_crc ? CRC : NAK);
+        return;
+    }
+
+    int size = m_pending.size();
+    while (size > 0 && SUB == m_pending.at(size - 1))
+        --size;
+
+    m_file.write(m_pending.constData(), size);
+    addBytes(size);
+    m_pending.clear();
+
+    reply(ACK);
+    finish(true, tr("File received"));
+}
+
+void XModemTransfer::reply(char c)
+{
+    write(QByteArray(1, c));
+}
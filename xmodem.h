@@ -0,0 +1,85 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef XMODEM_H
+#define XMODEM_H
+
+#include "filetransfer.h"
+
+// XMODEM-1K and its batch variant YMODEM, both with CRC-16 blocks. A sender
+// falls back to 128 byte blocks with checksums when the receiver asks so, a
+// receiver asks so when the sender does not react to the CRC polls.
+class XModemTransfer : public FileTransfer
+{
+    Q_OBJECT
+
+public:
+    XModemTransfer(bool batch, QIODevice *device, QObject *parent = nullptr);
+
+    bool isBatch() const Q_DECL_OVERRIDE { return m_batch; }
+
+    void send(const QStringList &fileNames) Q_DECL_OVERRIDE;
+    void receive(const QString &path) Q_DECL_OVERRIDE;
+    void feed(const QByteArray &data) Q_DECL_OVERRIDE;
+
+protected:
+    void timeout() Q_DECL_OVERRIDE;
+
+private:
+    enum State {
+        Idle,
+        SendWaitStart,
+        SendWaitHeaderAck,
+        SendWaitDataStart,
+        SendWaitBlockAck,
+        SendWaitEotAck,
+        Receive
+    };
+
+    void feedSender(char c);
+    void feedReceiver();
+    void startFile();
+    void sendHeader();
+    void sendNextBlock();
+    void sendFrame(const QByteArray &frame, State state);
+    void retry();
+    QByteArray makeBlock(quint8 number, QByteArray data) const;
+
+    void receiveBlock(quint8 number, const QByteArray &data);
+    void receiveHeader(const QByteArray &data);
+    void receiveEot();
+    void reply(char c);
+
+    bool  m_batch;
+    bool  m_crc = true;
+    State m_state = Idle;
+
+    QByteArray m_rx;
+    QByteArray m_frame;
+    QByteArray m_pending;
+    QString m_path;
+    quint8 m_number = 1;
+    int m_blockData = 0;
+    int m_tries = 0;
+    int m_eots  = 0;
+    int m_files = 0;
+    qint64 m_remaining = -1;
+    bool m_expectHeader = false;
+    bool m_started = false;
+    bool m_cancelSeen = false;
+};
+
+#endif // XMODEM_H
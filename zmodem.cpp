@@ -0,0 +1,799 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QDateTime>
+#include <cctype>
+#include <QFileInfo>
+
+#include "zmodem.h"
+
+namespace {
+
+const char ZPAD  = '*';
+const char ZDLE  = 0x18;
+const char ZBIN  = 'A';
+const char ZHEX  = 'B';
+const char ZBIN32 = 'C';
+
+const char ZCRCE = 'h';
+const char ZCRCG = 'i';
+const char ZCRCQ = 'j';
+const char ZCRCW = 'k';
+const char ZRUB0 = 'l';
+const char ZRUB1 = 'm';
+
+const char XON = 0x11;
+
+enum FrameType {
+    ZRQINIT, ZRINIT, ZSINIT, ZACK, ZFILE, ZSKIP, ZNAK, ZABORT, ZFIN,
+    ZRPOS, ZDATA, ZEOF, ZFERR, ZCRC, ZCHALLENGE, ZCOMPL, ZCAN
+};
+
+// ZRINIT capabilities, ZF0.
+const quint32 CANFDX  = 0x01;
+const quint32 CANOVIO = 0x02;
+const quint32 CANFC32 = 0x20;
+const quint32 ESCCTL  = 0x40;
+
+// ZFILE conversion option, binary transfer.
+const quint32 ZCBIN = 1;
+
+const int SubpacketSize = 1024;
+const int MaxSubpacket  = 8192;
+const qint64 Window     = 16 * 1024;
+
+const int MaxRetries     = 10;
+const int InitTimeout    = 2000;
+const int ReplyTimeout   = 10000;
+const int StreamTimeout  = 60000;
+
+inline quint32 flags(quint32 f0)
+{
+    return f0 << 24;
+}
+
+} // namespace
+
+ZModemTransfer::ZModemTransfer(QIODevice *device, QObject *parent) :
+    FileTransfer(device, parent)
+{
+}
+
+void ZModemTransfer::send(const QStringList &fileNames)
+{
+    start();
+    m_sending = true;
+    m_queue = fileNames;
+    for (const QString &fileName : m_queue)
+        m_total += QFileInfo(fileName).size();
+
+    m_parse = SeekPad;
+    m_state = SendInit;
+    m_tries = 0;
+    m_files = 0;
+
+    // Starts the receiver if the other side is a shell.
+    write(QByteArray("rz\r"));
+    sendHexHeader(ZRQINIT, 0);
+    restartTimeout(InitTimeout);
+}
+
+void ZModemTransfer::receive(const QString &path)
+{
+    start();
+    m_sending = false;
+    m_path = path;
+    m_parse = SeekPad;
+    m_state = ReceiveInit;
+    m_tries = 0;
+    m_files = 0;
+
+    sendReceiverInit();
+    restartTimeout(InitTimeout);
+}
+
+void ZModemTransfer::feed(const QByteArray &data)
+{
+    if (!isRunning())
+        return;
+
+    if (ReceiveFin == m_state) {
+        // Waiting for the "OO" that closes the session.
+        m_ohs += data.count('O');
+        if (m_ohs >= 2)
+            finish(true, tr("%n file(s) received", nullptr, m_files));
+        return;
+    }
+
+    if (ReceiveData == m_state)
+        restartTimeout(ReplyTimeout);
+
+    for (char c : data) {
+        parse(c);
+        if (!isRunning())
+            return;
+    }
+}
+
+void ZModemTransfer::timeout()
+{
+    if (++m_tries > MaxRetries) {
+        abort(tr("No response from the remote side"));
+        return;
+    }
+
+    // Only the "OO" after our ZFIN is missing, the files are complete.
+    if (ReceiveFin == m_state) {
+        finish(true, tr("%n file(s) received", nullptr, m_files));
+        return;
+    }
+
+    resend();
+}
+
+// Sends again whatever the current state waits for an answer to.
+void ZModemTransfer::resend()
+{
+    ++m_retries;
+
+    switch (m_state) {
+    case SendInit:
+        sendHexHeader(ZRQINIT, 0);
+        restartTimeout(InitTimeout);
+        break;
+    case SendFileInfo:
+        sendFileInfo();
+        break;
+    case Streaming:
+    case WaitAck:
+        seek(m_pos);
+        break;
+    case SendEof:
+        sendBinHeader(ZEOF, quint32(m_pos));
+        restartTimeout(ReplyTimeout);
+        break;
+    case SendFin:
+        sendHexHeader(ZFIN, 0);
+        restartTimeout(InitTimeout);
+        break;
+    case ReceiveInit:
+        sendReceiverInit();
+        restartTimeout(InitTimeout);
+        break;
+    case ReceiveData:
+        m_parse = SeekPad;
+        sendHexHeader(ZRPOS, quint32(m_pos));
+        restartTimeout(ReplyTimeout);
+        break;
+    case ReceiveFin:
+    case Idle:
+        break;
+    }
+}
+
+void ZModemTransfer::outputReady()
+{
+    if (Streaming == m_state)
+        pump();
+}
+
+void ZModemTransfer::parse(char c)
+{
+    // Five CAN in a row abort the session, ZDLE is the same code.
+    if (ZDLE == c) {
+        if (++m_cans >= 5) {
+            finish(false, tr("Cancelled by the remote side"));
+            return;
+        }
+    } else {
+        m_cans = 0;
+    }
+
+    switch (m_parse) {
+    case SeekPad:
+        if (ZPAD == c)
+            m_parse = SeekZdle;
+        break;
+
+    case SeekZdle:
+        if (ZDLE == c)
+            m_parse = SeekFormat;
+        else if (ZPAD != c)
+            m_parse = SeekPad;
+        break;
+
+    case SeekFormat:
+        m_buffer.clear();
+        m_escaped = false;
+        if (ZHEX == c) {
+            m_parse = HexHeader;
+            m_headerSize = 14;
+            m_rxCrc32 = false;
+        } else if (ZBIN == c || ZBIN32 == c) {
+            m_parse = BinHeader;
+            m_rxCrc32 = ZBIN32 == c;
+            m_headerSize = m_rxCrc32 ? 9 : 7;
+        } else {
+            m_parse = SeekPad;
+        }
+        break;
+
+    case HexHeader:
+        if (!isxdigit(uchar(c))) {
+            m_parse = SeekPad;
+            break;
+        }
+        m_buffer.append(c);
+        if (m_buffer.size() == m_headerSize) {
+            m_buffer = QByteArray::fromHex(m_buffer);
+            headerReceived();
+        }
+        break;
+
+    case BinHeader: {
+        char decoded;
+        bool end = false;
+        if (!unescape(c, &decoded, &end))
+            break;
+        if (end) {
+            m_parse = SeekPad;
+            break;
+        }
+        m_buffer.append(decoded);
+        if (m_buffer.size() == m_headerSize)
+            headerReceived();
+        break;
+    }
+
+    case DataSubpacket: {
+        char decoded;
+        bool end = false;
+        if (!unescape(c, &decoded, &end))
+            break;
+
+        if (m_inCrc) {
+            m_crc.append(decoded);
+            if (m_crc.size() == (m_rxCrc32 ? 4 : 2))
+                subpacketReceived();
+        } else if (end) {
+            m_frameEnd = decoded;
+            m_inCrc = true;
+            m_crc.clear();
+        } else if (m_buffer.size() < MaxSubpacket) {
+            m_buffer.append(decoded);
+        } else {
+            dataError();
+        }
+        break;
+    }
+    }
+}
+
+bool ZModemTransfer::unescape(char c, char *out, bool *end)
+{
+    if (m_escaped) {
+        m_escaped = false;
+        switch (c) {
+        case ZCRCE:
+        case ZCRCG:
+        case ZCRCQ:
+        case ZCRCW:
+            *out = c;
+            *end = true;
+            return true;
+        case ZRUB0:
+            *out = char(0x7F);
+            return true;
+        case ZRUB1:
+            *out = char(0xFF);
+            return true;
+        default:
+            *out = char(c ^ 0x40);
+            return true;
+        }
+    }
+
+    if (ZDLE == c) {
+        m_escaped = true;
+        return false;
+    }
+
+    // Flow control characters are always escaped by the sender.
+    const uchar u = uchar(c) & 0x7F;
+    if (0x11 == u || 0x13 == u)
+        return false;
+
+    *out = c;
+    return true;
+}
+
+void ZModemTransfer::headerReceived()
+{
+    m_parse = SeekPad;
+
+    const char *h = m_buffer.constData();
+    bool valid = false;
+    if (m_buffer.size() < 7) {
+        valid = false;
+    } else if (m_rxCrc32) {
+        const quint32 crc = ~crc32(h, 5);
+        valid = crc == (quint32(uchar(h[5])) | quint32(uchar(h[6])) << 8
+                        | quint32(uchar(h[7])) << 16 | quint32(uchar(h[8])) << 24);
+    } else {
+        valid = crc16(h, 5) == quint16(uchar(h[5]) << 8 | uchar(h[6]));
+    }
+
+    if (!valid) {
+        ++m_errors;
+        return;
+    }
+
+    const int type = uchar(h[0]);
+    const quint32 value = quint32(uchar(h[1])) | quint32(uchar(h[2])) << 8
+            | quint32(uchar(h[3])) << 16 | quint32(uchar(h[4])) << 24;
+
+    switch (type) {
+    case ZABORT:
+    case ZFERR:
+    case ZCAN:
+        finish(false, tr("Aborted by the remote side"));
+        return;
+    case ZNAK:
+        // The last header of another state may have gone out since, for
+        // example an acknowledgement; the state knows what was rejected.
+        resend();
+        return;
+    default:
+        break;
+    }
+
+    if (m_sending)
+        senderHeader(type, value);
+    else
+        receiverHeader(type, value);
+}
+
+void ZModemTransfer::expectSubpacket(int type)
+{
+    m_frameType = type;
+    m_parse = DataSubpacket;
+    m_buffer.clear();
+    m_escaped = false;
+    m_inCrc = false;
+}
+
+void ZModemTransfer::subpacketReceived()
+{
+    const char *crc = m_crc.constData();
+    bool valid;
+    if (m_rxCrc32) {
+        const quint32 value = ~crc32(&m_frameEnd, 1, crc32(m_buffer.constData(), m_buffer.size()));
+        valid = value == (quint32(uchar(crc[0])) | quint32(uchar(crc[1])) << 8
+                          | quint32(uchar(crc[2])) << 16 | quint32(uchar(crc[3])) << 24);
+    } else {
+        const quint16 value = crc16(&m_frameEnd, 1, crc16(m_buffer.constData(), m_buffer.size()));
+        valid = value == quint16(uchar(crc[0]) << 8 | uchar(crc[1]));
+    }
+
+    if (!valid) {
+        dataError();
+        return;
+    }
+
+    const QByteArray data = m_buffer;
+    const char end = m_frameEnd;
+
+    // Only ZCRCG and ZCRCQ are followed by another subpacket.
+    if (ZCRCG == end || ZCRCQ == end)
+        expectSubpacket(m_frameType);
+    else
+        m_parse = SeekPad;
+
+    switch (m_frameType) {
+    case ZSINIT:
+        sendHexHeader(ZACK, 0);
+        break;
+
+    case ZFILE: {
+        // Repeated because our ZRPOS got lost, the file is already open.
+        if (ReceiveData == m_state && m_file.isOpen() && 0 == m_pos) {
+            sendHexHeader(ZRPOS, 0);
+            break;
+        }
+
+        const int nameEnd = data.indexOf('\0');
+        const QByteArray name = data.left(nameEnd);
+        const QList<QByteArray> fields = data.mid(nameEnd + 1).split(' ');
+        m_total += qMax<qint64>(0, fields.value(0).toLongLong());
+
+        if (m_file.isOpen())
+            m_file.close();
+
+        m_file.setFileName(uniqueFileName(m_path, QString::fromLocal8Bit(name)));
+        if (!m_file.open(QIODevice::WriteOnly)) {
+            abort(m_file.errorString());
+            return;
+        }
+
+        m_pos = 0;
+        m_state = ReceiveData;
+        m_tries = 0;
+        sendHexHeader(ZRPOS, 0);
+        restartTimeout(ReplyTimeout);
+        break;
+    }
+
+    case ZDATA:
+        m_file.write(data);
+        m_pos += data.size();
+        m_tries = 0;
+        addBytes(data.size());
+
+        if (ZCRCQ == end || ZCRCW == end)
+            sendHexHeader(ZACK, quint32(m_pos));
+        break;
+
+    default:
+        break;
+    }
+}
+
+void ZModemTransfer::dataError()
+{
+    ++m_errors;
+    m_parse = SeekPad;
+
+    if (m_sending)
+        return;
+
+    if (ZDATA == m_frameType) {
+        ++m_retries;
+        sendHexHeader(ZRPOS, quint32(m_pos));
+    } else {
+        // Makes the sender repeat the file information.
+        sendReceiverInit();
+    }
+}
+
+void ZModemTransfer::senderHeader(int type, quint32 value)
+{
+    switch (type) {
+    case ZRINIT:
+        if (SendInit == m_state) {
+            const quint32 f0 = value >> 24;
+            m_txCrc32 = 0 != (f0 & CANFC32);
+            m_escapeCtl = 0 != (f0 & ESCCTL);
+            m_rxBufferSize = int(value & 0xFFFF);
+            m_tries = 0;
+            sendNextFile();
+        } else if (SendEof == m_state) {
+            m_file.close();
+            ++m_files;
+            m_tries = 0;
+            sendNextFile();
+        } else if (SendFileInfo == m_state) {
+            sendFileInfo();
+        }
+        break;
+
+    case ZRPOS:
+        if (SendFileInfo == m_state) {
+            m_tries = 0;
+            seek(value);
+        } else if (Streaming == m_state || WaitAck == m_state || SendEof == m_state) {
+            // The receiver lost data, everything after that position is
+            // sent again. The stale frame is closed first.
+            ++m_retries;
+            if (qint64(value) != m_errorPos) {
+                m_errorPos = value;
+                m_tries = 0;
+            }
+            if (++m_tries > MaxRetries) {
+                abort(tr("Too many retries"));
+                return;
+            }
+            m_done -= m_pos - qint64(value);
+            sendSubpacket(QByteArray(), ZCRCE);
+            seek(value);
+        }
+        break;
+
+    case ZACK:
+        if (WaitAck == m_state && qint64(value) == m_pos) {
+            m_tries = 0;
+            seek(m_pos);
+        }
+        break;
+
+    case ZSKIP:
+        if (SendFileInfo == m_state || Streaming == m_state || WaitAck == m_state) {
+            m_done += m_file.size() - m_pos;
+            m_file.close();
+            sendNextFile();
+        }
+        break;
+
+    case ZCRC: {
+        // The receiver compares the file with the one it already has.
+        const qint64 pos = m_file.pos();
+        m_file.seek(0);
+        quint32 crc = 0xFFFFFFFF;
+        while (!m_file.atEnd()) {
+            const QByteArray chunk = m_file.read(64 * 1024);
+            crc = crc32(chunk.constData(), chunk.size(), crc);
+        }
+        m_file.seek(pos);
+        sendHexHeader(ZCRC, ~crc);
+        break;
+    }
+
+    case ZFIN:
+        if (SendFin == m_state) {
+            write(QByteArray("OO"));
+            finish(true, tr("%n file(s) sent", nullptr, m_files));
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void ZModemTransfer::receiverHeader(int type, quint32 value)
+{
+    switch (type) {
+    case ZRQINIT:
+        if (ReceiveInit == m_state)
+            sendReceiverInit();
+        break;
+
+    case ZSINIT:
+    case ZFILE:
+        expectSubpacket(type);
+        break;
+
+    case ZDATA:
+        if (ReceiveData != m_state)
+            break;
+
+        if (qint64(value) == m_pos) {
+            expectSubpacket(ZDATA);
+        } else {
+            ++m_retries;
+            sendHexHeader(ZRPOS, quint32(m_pos));
+        }
+        break;
+
+    case ZEOF:
+        // A position behind ours means the data is still under way.
+        if (ReceiveData == m_state && qint64(value) == m_pos) {
+            m_file.close();
+            ++m_files;
+            m_state = ReceiveInit;
+            m_tries = 0;
+            sendReceiverInit();
+            restartTimeout(ReplyTimeout);
+        }
+        break;
+
+    case ZFIN:
+        sendHexHeader(ZFIN, 0);
+        m_state = ReceiveFin;
+        m_ohs = 0;
+        restartTimeout(InitTimeout);
+        break;
+
+    default:
+        break;
+    }
+}
+
+void ZModemTransfer::sendNextFile()
+{
+    if (m_queue.isEmpty()) {
+        m_state = SendFin;
+        sendHexHeader(ZFIN, 0);
+        restartTimeout(InitTimeout);
+        return;
+    }
+
+    m_file.setFileName(m_queue.takeFirst());
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        abort(m_file.errorString());
+        return;
+    }
+
+    m_pos = 0;
+    m_errorPos = -1;
+    sendFileInfo();
+}
+
+void ZModemTransfer::sendFileInfo()
+{
+    const QFileInfo info(m_file);
+
+    qint64 bytesLeft = 0;
+    for (const QString &fileName : m_queue)
+        bytesLeft += QFileInfo(fileName).size();
+
+    const QByteArray data = info.fileName().toLocal8Bit() + '\0'
+            + QByteArray::number(info.size()) + ' '
+            + QByteArray::number(info.lastModified().toMSecsSinceEpoch() / 1000, 8) + " 100644 0 "
+            + QByteArray::number(m_queue.size() + 1) + ' '
+            + QByteArray::number(bytesLeft + info.size()) + '\0';
+
+    m_state = SendFileInfo;
+    sendBinHeader(ZFILE, flags(ZCBIN));
+    sendSubpacket(data, ZCRCW);
+    restartTimeout(ReplyTimeout);
+}
+
+void ZModemTransfer::seek(qint64 pos)
+{
+    if (!m_file.seek(pos)) {
+        abort(m_file.errorString());
+        return;
+    }
+
+    m_pos = pos;
+    m_sinceAck = 0;
+    m_state = Streaming;
+    sendBinHeader(ZDATA, quint32(pos));
+    pump();
+}
+
+void ZModemTransfer::pump()
+{
+    // The port buffer is kept short so that a ZRPOS takes effect quickly.
+    while (Streaming == m_state && m_device->bytesToWrite() < Window) {
+        const QByteArray data = m_file.read(SubpacketSize);
+        m_pos += data.size();
+        m_sinceAck += data.size();
+        addBytes(data.size());
+
+        if (m_file.atEnd()) {
+            sendSubpacket(data, ZCRCE);
+            sendBinHeader(ZEOF, quint32(m_pos));
+            m_state = SendEof;
+            m_tries = 0;
+            restartTimeout(ReplyTimeout);
+            return;
+        }
+
+        if (m_rxBufferSize && m_sinceAck + SubpacketSize > m_rxBufferSize) {
+            sendSubpacket(data, ZCRCW);
+            m_state = WaitAck;
+            restartTimeout(ReplyTimeout);
+            return;
+        }
+
+        sendSubpacket(data, ZCRCG);
+    }
+
+    restartTimeout(StreamTimeout);
+}
+
+void ZModemTransfer::sendHexHeader(int type, quint32 value)
+{
+    char raw[5] = {
+        char(type), char(value & 0xFF), char((value >> 8) & 0xFF),
+        char((value >> 16) & 0xFF), char((value >> 24) & 0xFF)
+    };
+    const quint16 crc = crc16(raw, 5);
+    const char crcBytes[2] = { char(crc >> 8), char(crc & 0xFF) };
+
+    QByteArray header;
+    header.append(ZPAD).append(ZPAD).append(ZDLE).append(ZHEX);
+    header.append(QByteArray(raw, 5).toHex());
+    header.append(QByteArray(crcBytes, 2).toHex());
+    header.append('\r').append(char(0x8A));
+    if (ZACK != type && ZFIN != type)
+        header.append(XON);
+
+    write(header);
+}
+
+void ZModemTransfer::sendBinHeader(int type, quint32 value)
+{
+    char raw[5] = {
+        char(type), char(value & 0xFF), char((value >> 8) & 0xFF),
+        char((value >> 16) & 0xFF), char((value >> 24) & 0xFF)
+    };
+
+    QByteArray header;
+    header.append(ZPAD).append(ZDLE).append(m_txCrc32 ? ZBIN32 : ZBIN);
+    for (char c : raw)
+        escape(header, c);
+
+    if (m_txCrc32) {
+        const quint32 crc = ~crc32(raw, 5);
+        for (int i = 0; i < 4; ++i)
+            escape(header, char((crc >> (8 * i)) & 0xFF));
+    } else {
+        const quint16 crc = crc16(raw, 5);
+        escape(header, char(crc >> 8));
+        escape(header, char(crc & 0xFF));
+    }
+
+    write(header);
+}
+
+void ZModemTransfer::sendSubpacket(const QByteArray &data, char end)
+{
+    QByteArray packet;
+    packet.reserve(data.size() * 2 + 12);
+    for (char c : data)
+        escape(packet, c);
+
+    packet.append(ZDLE).append(end);
+
+    if (m_txCrc32) {
+        const quint32 crc = ~crc32(&end, 1, crc32(data.constData(), data.size()));
+        for (int i = 0; i < 4; ++i)
+            escape(packet, char((crc >> (8 * i)) & 0xFF));
+    } else {
+        const quint16 crc = crc16(&end, 1, crc16(data.constData(), data.size()));
+        escape(packet, char(crc >> 8));
+        escape(packet, char(crc & 0xFF));
+    }
+
+    // A frame that waits for an answer makes the receiver talk, give it XON.
+    if (ZCRCW == end)
+        packet.append(XON);
+
+    write(packet);
+}
+
+void ZModemTransfer::sendReceiverInit()
+{
+    m_txCrc32 = false;
+    sendHexHeader(ZRINIT, flags(CANFDX | CANOVIO | CANFC32));
+}
+
+void ZModemTransfer::escape(QByteArray &out, char c)
+{
+    const uchar u = uchar(c);
+    bool escaped;
+
+    switch (u) {
+    case 0x18: // ZDLE
+    case 0x10: // DLE
+    case 0x11: // XON
+    case 0x13: // XOFF
+    case 0x90:
+    case 0x91:
+    case 0x93:
+        escaped = true;
+        break;
+    case 0x0D:
+    case 0x8D:
+        // Telenet command escape is CR-@-CR.
+        escaped = m_escapeCtl || '@' == (m_lastSent & 0x7F);
+        break;
+    default:
+        escaped = m_escapeCtl && 0 == (u & 0x60);
+        break;
+    }
+
+    if (escaped) {
+        out.append(ZDLE);
+        out.append(char(u ^ 0x40));
+    } else {
+        out.append(c);
+    }
+
+    m_lastSent = c;
+}
@@ -0,0 +1,118 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Sergey Kovalenko <seryoga.engineering@gmail.com>
+**
+** This file is part of the Simple Terminal application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 3 as published by the Free Software Foundation and
+** appearing in the file LICENSE included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser
+** General Public License requirements will be met:
+** https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef ZMODEM_H
+#define ZMODEM_H
+
+#include "filetransfer.h"
+
+// ZMODEM sender and receiver. Data goes out as one continuous frame of
+// ZCRCG subpackets without waiting for acknowledgements, the receiver asks
+// for a retransmission with ZRPOS only when something is damaged. Receivers
+// that announce a limited buffer are served with ZCRCW windows instead.
+class ZModemTransfer : public FileTransfer
+{
+    Q_OBJECT
+
+public:
+    explicit ZModemTransfer(QIODevice *device, QObject *parent = nullptr);
+
+    bool isBatch() const Q_DECL_OVERRIDE { return true; }
+
+    void send(const QStringList &fileNames) Q_DECL_OVERRIDE;
+    void receive(const QString &path) Q_DECL_OVERRIDE;
+    void feed(const QByteArray &data) Q_DECL_OVERRIDE;
+
+protected:
+    void timeout() Q_DECL_OVERRIDE;
+    void outputReady() Q_DECL_OVERRIDE;
+
+private:
+    enum Parse {
+        SeekPad,
+        SeekZdle,
+        SeekFormat,
+        HexHeader,
+        BinHeader,
+        DataSubpacket
+    };
+
+    enum State {
+        Idle,
+        SendInit,
+        SendFileInfo,
+        Streaming,
+        WaitAck,
+        SendEof,
+        SendFin,
+        ReceiveInit,
+        ReceiveData,
+        ReceiveFin
+    };
+
+    void parse(char c);
+    bool unescape(char c, char *out, bool *end);
+    void headerReceived();
+    void expectSubpacket(int type);
+    void subpacketReceived();
+    void dataError();
+    void resend();
+
+    void senderHeader(int type, quint32 value);
+    void receiverHeader(int type, quint32 value);
+
+    void sendNextFile();
+    void sendFileInfo();
+    void seek(qint64 pos);
+    void pump();
+
+    void sendHexHeader(int type, quint32 value);
+    void sendBinHeader(int type, quint32 value);
+    void sendSubpacket(const QByteArray &data, char end);
+    void sendReceiverInit();
+    void escape(QByteArray &out, char c);
+
+    State m_state = Idle;
+    bool  m_sending = false;
+
+    // Parser
+    Parse m_parse = SeekPad;
+    QByteArray m_buffer;
+    QByteArray m_crc;
+    int  m_headerSize = 0;
+    int  m_cans = 0;
+    int  m_frameType = 0;
+    char m_frameEnd = 0;
+    bool m_escaped = false;
+    bool m_rxCrc32 = false;
+    bool m_inCrc = false;
+
+    // Link options
+    bool m_txCrc32 = false;
+    bool m_escapeCtl = false;
+    char m_lastSent = 0;
+    int  m_rxBufferSize = 0;
+
+    QString m_path;
+    qint64 m_pos = 0;
+    qint64 m_sinceAck = 0;
+    qint64 m_errorPos = -1;
+    int m_tries = 0;
+    int m_files = 0;
+    int m_ohs = 0;
+};
+
+#endif // ZMODEM_H